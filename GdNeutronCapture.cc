@@ -29,42 +29,240 @@
 
 #include "DetectorConstruction.hh"
 #include "ActionInitialization.hh"
+#include "Benchmark.hh"
+#include "EventModuloTuner.hh"
+#include "GeometrySweep.hh"
+#include "MemoryMonitor.hh"
+#include "HPDataSubset.hh"
+#include "PhysicsListComparison.hh"
+#include "PhysicsTableCache.hh"
+#include "RunSummary.hh"
+#include "StartupMonitor.hh"
 
 #include "G4RunManagerFactory.hh"
+#include "G4MTRunManager.hh"
+#include "G4Threading.hh"
 #include "G4SteppingVerbose.hh"
 #include "G4UImanager.hh"
-#include "QBBC.hh"
 
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
 
 #include "Randomize.hh"
 
-#include "QGSP_BIC_AllHP.hh"
-#include "QGSP_BIC_HP.hh"
-#include "QGSP_BERT_HP.hh"
-#include "QGSP_INCLXX_HP.hh"
-#include "FTFP_INCLXX_HP.hh"
-#include "FTFP_BERT_HP.hh"
-#include "FTFP_BERT.hh"
-#include "ShieldingLEND.hh"
+#include <cstdlib>
+#include <sstream>
 
+#include "G4PhysListFactory.hh"
 #include "G4ParticleHPManager.hh"
+#include "G4GenericBiasingPhysics.hh"
 
 using namespace GdNCap;
 
+namespace
+{
+  void PrintUsage()
+  {
+    G4cerr << " Usage: " << G4endl
+           << " GdNeutronCapture [-s stepping|sd] [-b] [-p list] [-c list,list,...]" << G4endl
+           << "                  [-r file] [-t directory] [-n directory] [-v]" << G4endl
+           << "                  [-m default|serial|mt|tasking|tbb] [-j threads|all]" << G4endl
+           << "                  [-e modulo] [macro]" << G4endl
+           << " GdNeutronCapture -B threads|all [-o file] [options] macro..." << G4endl
+           << "   -s : score with the stepping action (default) or with a" << G4endl
+           << "        sensitive detector on the envelope and a tracking action" << G4endl
+           << "   -b : add generic biasing of the neutrons to the physics list," << G4endl
+           << "        for the modes of /GdNCap/biasing/mode" << G4endl
+           << "   -p : reference physics list (default $GDNCAP_PHYSICS_LIST or" << G4endl
+           << "        QGSP_BIC_AllHP), e.g. QGSP_BIC_HP, FTFP_BERT_HP, ShieldingLEND" << G4endl
+           << "   -c : run the macro once per physics list, in child processes," << G4endl
+           << "        and compare startup, throughput, memory and gamma spectra" << G4endl
+           << "   -r : write the startup and run times to a summary file" << G4endl
+           << "   -t : cache the physics tables in a directory (default" << G4endl
+           << "        $GDNCAP_TABLE_CACHE), retrieved by later jobs" << G4endl
+           << "   -n : read the neutron HP data from a subset made by gdncap-hpprep" << G4endl
+           << "        (default $GDNCAP_HP_DATA)" << G4endl
+           << "   -v : initialize the visualization in batch mode too, e.g. for" << G4endl
+           << "        tsg_offscreen.mac (always done in interactive mode)" << G4endl
+           << "   -m : run manager type (default: $G4RUN_MANAGER_TYPE or Geant4's)" << G4endl
+           << "   -j : number of threads, all = all cores (default: Geant4's in" << G4endl
+           << "        batch mode, 1 in interactive mode)" << G4endl
+           << "   -e : events a worker takes at once, as /run/eventModulo; see" << G4endl
+           << "        also /GdNCap/run/tuneEventModulo" << G4endl
+           << "   -B : benchmark, run each macro in child processes on 1, 2, 4, ..." << G4endl
+           << "        threads and write the timings as JSON (-o, default bench.json)" << G4endl;
+  }
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 int main(int argc,char** argv)
 {
+  // Evaluate arguments
+  //
+  G4String macro;
+  std::vector<G4String> macros;
+  auto scoringMode = DetectorConstruction::ScoringMode::Stepping;
+  G4bool biasing = false;
+  G4String physicsListName = "QGSP_BIC_AllHP";
+  if (const char* name = std::getenv("GDNCAP_PHYSICS_LIST")) physicsListName = name;
+  std::vector<G4String> comparedLists;
+  G4String summaryFile;
+  G4String tableCache;
+  if (const char* directory = std::getenv("GDNCAP_TABLE_CACHE")) tableCache = directory;
+  G4String hpData;
+  G4bool batchVis = false;
+  auto runManagerType = G4RunManagerType::Default;
+  G4int nofThreads = 0;
+  G4int eventModulo = 0;
+  G4int benchThreads = 0;
+  G4String benchFile = "bench.json";
+  if (const char* directory = std::getenv("GDNCAP_HP_DATA")) hpData = directory;
+  std::vector<G4String> childArguments;
+  for (G4int i = 1; i < argc; ++i) {
+    G4String argument = argv[i];
+    if (argument == "-s" && i + 1 < argc) {
+      G4String mode = argv[++i];
+      if (mode == "sd") scoringMode = DetectorConstruction::ScoringMode::SensitiveDetector;
+      else if (mode == "stepping") scoringMode = DetectorConstruction::ScoringMode::Stepping;
+      else {
+        PrintUsage();
+        return 1;
+      }
+      childArguments.insert(childArguments.end(), { argument, mode });
+    }
+    else if (argument == "-b") {
+      biasing = true;
+      childArguments.push_back(argument);
+    }
+    else if (argument == "-p" && i + 1 < argc) {
+      physicsListName = argv[++i];
+    }
+    else if (argument == "-c" && i + 1 < argc) {
+      std::istringstream lists(argv[++i]);
+      G4String name;
+      while (std::getline(lists, name, ',')) {
+        if (!name.empty()) comparedLists.push_back(name);
+      }
+    }
+    else if (argument == "-r" && i + 1 < argc) {
+      summaryFile = argv[++i];
+    }
+    else if (argument == "-t" && i + 1 < argc) {
+      tableCache = argv[++i];
+      childArguments.insert(childArguments.end(), { argument, tableCache });
+    }
+    else if (argument == "-n" && i + 1 < argc) {
+      hpData = argv[++i];
+      childArguments.insert(childArguments.end(), { argument, hpData });
+    }
+    else if (argument == "-v") {
+      batchVis = true;
+    }
+    else if (argument == "-m" && i + 1 < argc) {
+      G4String type = argv[++i];
+      if (type == "default") runManagerType = G4RunManagerType::Default;
+      else if (type == "serial") runManagerType = G4RunManagerType::Serial;
+      else if (type == "mt") runManagerType = G4RunManagerType::MT;
+      else if (type == "tasking") runManagerType = G4RunManagerType::Tasking;
+      else if (type == "tbb") runManagerType = G4RunManagerType::TBB;
+      else {
+        PrintUsage();
+        return 1;
+      }
+      childArguments.insert(childArguments.end(), { argument, type });
+    }
+    else if (argument == "-j" && i + 1 < argc) {
+      G4String threads = argv[++i];
+      nofThreads = threads == "all" ? G4Threading::G4GetNumberOfCores()
+                                    : std::atoi(threads.c_str());
+      if (nofThreads <= 0) {
+        PrintUsage();
+        return 1;
+      }
+      childArguments.insert(childArguments.end(), { argument, threads });
+    }
+    else if (argument == "-e" && i + 1 < argc) {
+      G4String modulo = argv[++i];
+      eventModulo = std::atoi(modulo.c_str());
+      if (eventModulo <= 0) {
+        PrintUsage();
+        return 1;
+      }
+      childArguments.insert(childArguments.end(), { argument, modulo });
+    }
+    else if (argument == "-B" && i + 1 < argc) {
+      G4String threads = argv[++i];
+      benchThreads = threads == "all" ? G4Threading::G4GetNumberOfCores()
+                                      : std::atoi(threads.c_str());
+      if (benchThreads <= 0) {
+        PrintUsage();
+        return 1;
+      }
+    }
+    else if (argument == "-o" && i + 1 < argc) {
+      benchFile = argv[++i];
+    }
+    else {
+      macros.push_back(argument);
+    }
+  }
+  if (macros.size() > 1 && benchThreads == 0) {
+    PrintUsage();
+    return 1;
+  }
+  if (!macros.empty()) macro = macros.front();
+
+  // Compare physics lists, each in a child process of this program
+  //
+  if (!comparedLists.empty()) {
+    if (macro.empty()) {
+      PrintUsage();
+      return 1;
+    }
+    PhysicsListComparison comparison(argv[0], macro, childArguments);
+    return comparison.Run(comparedLists) ? 0 : 1;
+  }
+
+  // Check the physics list before anything is built
+  //
+  G4PhysListFactory physListFactory;
+  if (!physListFactory.IsReferencePhysList(physicsListName)) {
+    G4cerr << " Unknown physics list " << physicsListName << G4endl;
+    physListFactory.AvailablePhysLists();
+    return 1;
+  }
+
+  // Benchmark, each macro and thread count in a child process
+  //
+  if (benchThreads > 0) {
+    if (macros.empty()) {
+      PrintUsage();
+      return 1;
+    }
+    childArguments.insert(childArguments.end(), { "-p", physicsListName });
+    Benchmark benchmark(argv[0], macros, childArguments);
+    return benchmark.Run(benchThreads, benchFile) ? 0 : 1;
+  }
+
+  // Profile the startup up to the first event
+  // (owned and deleted by the state manager)
+  auto startupMonitor = new StartupMonitor();
+  if (!summaryFile.empty()) {
+    RunSummary::Instance()->Open(summaryFile);
+    RunSummary::Instance()->AddEntry("physicsList", physicsListName);
+  }
+
     // Choose the Random engine
+    startupMonitor->BeginPhase("rng");
     G4Random::setTheEngine(new CLHEP::RanecuEngine);
     auto seed = time(NULL);
     G4Random::setTheSeed(seed);
-  // Detect interactive mode (if no arguments) and define UI session
+    startupMonitor->EndPhase();
+  // Detect interactive mode (if no macro) and define UI session
   //
   G4UIExecutive* ui = nullptr;
-  if ( argc == 1 ) { ui = new G4UIExecutive(argc, argv); }
+  if ( macro.empty() ) { ui = new G4UIExecutive(argc, argv); }
 
   // Optionally: choose a different Random engine...
   // G4Random::setTheEngine(new CLHEP::MTwistEngine);
@@ -73,45 +271,80 @@ int main(int argc,char** argv)
   G4int precision = 4;
   G4SteppingVerbose::UseBestUnit(precision);
 
-  // Construct the default run manager
+  // Construct the run manager, one thread in interactive mode unless asked
   //
-  auto* runManager =
-    G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+  startupMonitor->BeginPhase("runManager");
+  auto* runManager = G4RunManagerFactory::CreateRunManager(runManagerType);
+  if (nofThreads == 0 && ui) nofThreads = 1;
+  if (nofThreads > 0) runManager->SetNumberOfThreads(nofThreads);
+  // The tasking run manager derives from the MT one
+  auto mtRunManager = dynamic_cast<G4MTRunManager*>(runManager);
+  if (eventModulo > 0 && mtRunManager) mtRunManager->SetEventModulo(eventModulo);
+  startupMonitor->EndPhase();
 
   // Set mandatory initialization classes
   //
   // Detector construction
-  runManager->SetUserInitialization(new DetectorConstruction());
+  auto detConstruction = new DetectorConstruction();
+  detConstruction->SetScoringMode(scoringMode);
+  detConstruction->SetBiasing(biasing);
+  runManager->SetUserInitialization(detConstruction);
 
   // Physics list
-  //G4VModularPhysicsList* physicsList = new QGSP_BIC_HP;
-  G4VModularPhysicsList* physicsList = new QGSP_BIC_AllHP;
-  //G4VModularPhysicsList* physicsList = new ShieldingLEND;
-  //G4VModularPhysicsList* physicsList = new FTFP_BERT_HP;
-  //G4VModularPhysicsList* physicsList = new FTFP_INCLXX_HP;
-  //G4VModularPhysicsList* physicsList = new FTFP_BERT;
-  //G4VModularPhysicsList* physicsList = new QBBC;
-  physicsList->SetVerboseLevel(2);
+  G4VModularPhysicsList* physicsList =
+    physListFactory.GetReferencePhysList(physicsListName);
+  // Quiet in batch mode, /run/particle/verbose sets it again
+  physicsList->SetVerboseLevel(ui ? 2 : 0);
+  if (biasing) {
+    // Wraps the neutron processes, the biasing itself is chosen per run
+    auto biasingPhysics = new G4GenericBiasingPhysics();
+    biasingPhysics->Bias("neutron");
+    physicsList->RegisterPhysics(biasingPhysics);
+  }
   runManager->SetUserInitialization(physicsList);
+  if (!tableCache.empty()) {
+    // Owned and deleted by the state manager
+    new PhysicsTableCache(tableCache, physicsListName + (biasing ? "_biasing" : ""),
+                          physicsList);
+  }
 
   // User action initialization
-  runManager->SetUserInitialization(new ActionInitialization());
+  runManager->SetUserInitialization(new ActionInitialization(detConstruction));
 
   // Replaced HP environmental variables with C++ calls
   G4ParticleHPManager::GetInstance()->SetSkipMissingIsotopes(true);
   G4ParticleHPManager::GetInstance()->SetDoNotAdjustFinalState(true);
   G4ParticleHPManager::GetInstance()->SetUseOnlyPhotoEvaporation(true);
+  if (!hpData.empty()) {
+    // Sets G4NEUTRONHPDATA before the HP data are read; owned and deleted
+    // by the state manager
+    new HPDataSubset(hpData);
+  }
   //G4ParticleHPManager::GetInstance()->SetNeglectDoppler(false);
   //G4ParticleHPManager::GetInstance()->SetProduceFissionFragments(false);
   //G4ParticleHPManager::GetInstance()->SetUseWendtFissionModel(false);
   //G4ParticleHPManager::GetInstance()->SetUseNRESP71Model(false);
 
-  // Initialize visualization
+  // Initialize visualization, not needed by batch jobs unless asked for
   //
-  G4VisManager* visManager = new G4VisExecutive;
-  // G4VisExecutive can take a verbosity argument - see /vis/verbose guidance.
-  // G4VisManager* visManager = new G4VisExecutive("Quiet");
-  visManager->Initialize();
+  G4VisManager* visManager = nullptr;
+  if (ui || batchVis) {
+    startupMonitor->BeginPhase("vis");
+    visManager = new G4VisExecutive;
+    // G4VisExecutive can take a verbosity argument - see /vis/verbose guidance.
+    // G4VisManager* visManager = new G4VisExecutive("Quiet");
+    visManager->Initialize();
+    startupMonitor->EndPhase();
+  }
+
+  // Calibration of the event modulo, /GdNCap/run/tuneEventModulo
+  auto eventModuloTuner = new EventModuloTuner();
+
+  // Energy, thickness and material grid in one job, /GdNCap/sweep/run
+  auto geometrySweep = new GeometrySweep(detConstruction);
+
+  // Memory accounting of the runs, /GdNCap/memory/budget
+  auto memoryMonitor = new MemoryMonitor();
 
   // Get the pointer to the User Interface manager
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
@@ -121,11 +354,9 @@ int main(int argc,char** argv)
   if ( ! ui ) {
     // batch mode
     G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command+fileName);
+    UImanager->ApplyCommand(command+macro);
   }
   else {
-    runManager->SetNumberOfThreads(1);
     // interactive mode
     UImanager->ApplyCommand("/run/verbose 2");
     UImanager->ApplyCommand("/event/verbose 2");
@@ -140,6 +371,9 @@ int main(int argc,char** argv)
   // owned and deleted by the run manager, so they should not be deleted
   // in the main() program !
 
+  delete memoryMonitor;
+  delete geometrySweep;
+  delete eventModuloTuner;
   delete visManager;
   delete runManager;
 }
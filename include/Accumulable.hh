@@ -24,9 +24,16 @@
 // ********************************************************************
 //
 
-// Class template for accumulables handled by Geant4 analysis
+// Accumulable holding the per-event capture records of a run.
 //
-// Author: Ivana Hrivnacova, 07/09/2015  (ivana@ipno.in2p3.fr)
+// The records are kept column-wise in fixed-capacity CaptureRecordBlocks,
+// grouped in sequences of increasing event ID. Merging another accumulable
+// only appends handles to its sequences, so the cost of a merge does not
+// depend on the number of stored events, and reading the merged records
+// through GetView() yields them in event ID order whatever the merge order.
+//
+// When a block sink is set, full blocks are handed to it and recycled
+// instead of being kept, so the memory held stays bounded by one block.
 
 #ifndef GdNCapAccumulable_h
 #define GdNCapAccumulable_h 1
@@ -35,7 +42,11 @@
 
 #include "globals.hh"
 
-#include <list>
+#include "CaptureRecordBlock.hh"
+#include "CaptureRecordView.hh"
+
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace GdNCap
@@ -44,23 +55,45 @@ namespace GdNCap
     class Accumulable : public G4VAccumulable
     {
     public:
-        Accumulable();
-        ~Accumulable();
+        using BlockSink = std::function<void(const CaptureRecordBlock&)>;
+
+        Accumulable(std::size_t blockCapacity = CaptureRecordBlock::kDefaultCapacity);
+        ~Accumulable() = default;
 
         // Methods
         void Merge(const G4VAccumulable& other) final;
         void Reset() final;
 
         // Get methods
-        inline std::list<std::vector<std::pair<G4double, G4String>>> GetSecondariesList() const { return secondariesList; }
-        inline std::list<G4double> GetSecondariesEnergy() const { return secondariesEnergy; }
-        void PushSecondariesList(std::vector<std::pair<G4double, G4String>> fSecondaries);
-        void PushSecondariesEnergy(G4double fSecE);
+        // Valid until the next AddEvent(), Merge() or Reset(); sorts the open
+        // block in place
+        CaptureRecordView GetView() const;
+        // Bytes held by the blocks, shared ones included
+        std::size_t GetMemoryUsage() const;
+
+        // Set methods
+        void AddEvent(G4int eventId, G4double edep, G4double totalEnergy,
+                      const std::vector<G4double>& energies,
+                      const std::vector<CaptureRecordBlock::TypeId>& types,
+                      const std::vector<G4double>& weights);
+        void SetBlockCapacity(std::size_t capacity);
+        void SetBlockSink(BlockSink sink) { fBlockSink = std::move(sink); }
+
+        // Hand the partially filled block to the sink
+        void Flush();
 
     private:
+        using BlockHandle = std::shared_ptr<const CaptureRecordBlock>;
+        using Sequence = std::vector<BlockHandle>;
+
+        static void Append(std::vector<Sequence>& sequences, BlockHandle block);
+        void SinkOpenBlock();
+
         // Data members
-        std::list<std::vector<std::pair<G4double, G4String>>> secondariesList;
-        std::list<G4double> secondariesEnergy;
+        std::size_t fBlockCapacity;
+        std::vector<Sequence> fSequences;
+        std::shared_ptr<CaptureRecordBlock> fOpenBlock;
+        BlockSink fBlockSink;
     };
 
 }
@@ -33,18 +33,26 @@
 #include "G4VUserActionInitialization.hh"
 
 /// Action initialization class.
+///
+/// With the "sd" scoring mode of the detector construction, captures are
+/// recorded by a TrackingAction and no SteppingAction is registered.
 
 namespace GdNCap
 {
 
+class DetectorConstruction;
+
 class ActionInitialization : public G4VUserActionInitialization
 {
   public:
-    ActionInitialization() = default;
+    ActionInitialization(const DetectorConstruction* detConstruction);
     ~ActionInitialization() override = default;
 
     void BuildForMaster() const override;
     void Build() const override;
+
+  private:
+    const DetectorConstruction* fDetConstruction = nullptr;
 };
 
 }
@@ -0,0 +1,82 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/include/AliasTable.hh
+/// \brief Definition of the GdNCap::AliasTable class
+
+#ifndef GdNCapAliasTable_h
+#define GdNCapAliasTable_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+/// Walker's alias table of a discrete distribution, built with Vose's
+/// method: Sample() draws the index of a weight in constant time from a
+/// single uniform number, whatever the number of weights, where a search
+/// in the cumulative distribution takes a logarithmic time.
+///
+/// Each index i keeps the probability of drawing i itself and the index
+/// drawn otherwise, its alias; the integer part of u * n selects i and the
+/// fractional part decides between i and its alias.
+
+namespace GdNCap
+{
+
+class AliasTable
+{
+  public:
+    AliasTable() = default;
+    ~AliasTable() = default;
+
+    /// Returns false, leaving the table empty, unless the weights are
+    /// finite, non-negative and not all zero
+    G4bool Build(const std::vector<G4double>& weights);
+
+    /// u uniform in [0, 1); the table must not be empty
+    std::size_t Sample(G4double u) const
+    {
+      const G4double x = u * fProbabilities.size();
+      std::size_t i = static_cast<std::size_t>(x);
+      if (i >= fProbabilities.size()) i = fProbabilities.size() - 1;
+      return (x - i < fProbabilities[i]) ? i : fAliases[i];
+    }
+
+    std::size_t GetSize() const { return fProbabilities.size(); }
+    G4bool IsEmpty() const { return fProbabilities.empty(); }
+
+  private:
+    std::vector<G4double> fProbabilities;
+    std::vector<std::uint32_t> fAliases;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
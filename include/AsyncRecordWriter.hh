@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/AsyncRecordWriter.hh
+/// \brief Definition of the GdNCap::AsyncRecordWriter class
+
+#ifndef GdNCapAsyncRecordWriter_h
+#define GdNCapAsyncRecordWriter_h 1
+
+#include "CaptureRecordBlock.hh"
+#include "RecordQueue.hh"
+#include "VRecordWriter.hh"
+
+#include "G4Threading.hh"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+
+/// Writes capture records on a dedicated I/O thread while the event loop
+/// runs.
+///
+/// Worker threads Push() every completed event into a RecordQueue; when
+/// the queue is full they wait for the I/O thread (backpressure), so
+/// memory stays bounded and serialisation keeps pace with the simulation.
+/// The I/O thread drains the queue and restores the event ID order:
+/// records of one producer arrive in order, so it holds them per producer
+/// and emits the next event ID as soon as it has arrived (or the smallest
+/// pending one once every producer has a record pending). The records in
+/// the queue and held back this way are capped together at the queue
+/// capacity: while the cap is reached, a producer that already has records
+/// held waits before pushing, so a stalled worker cannot make the others
+/// grow the reorder buffer without bound. A producer with none held is let
+/// through, as it may hold the next event ID. In-order events
+/// are collected in a CaptureRecordBlock and passed to the record writer
+/// block by block, so any output format can be written asynchronously.
+
+namespace GdNCap
+{
+
+class AsyncRecordWriter
+{
+  public:
+    static constexpr std::size_t kDefaultQueueCapacity = 16384;
+
+    AsyncRecordWriter(std::unique_ptr<VRecordWriter> writer,
+                      std::size_t queueCapacity = kDefaultQueueCapacity);
+    ~AsyncRecordWriter();
+
+    /// Start the I/O thread, which opens the writer with the first record
+    void Start(G4int nofProducers, const G4String& suffix = "");
+    /// Thread-safe, the first call sets the run conditions of the file
+    /// header; call it before pushing the first record
+    void SetPrimary(const G4String& particleName, G4double energy);
+    /// Thread-safe, blocks while the queue is full or the records held
+    /// for reordering reach the cap
+    void Push(G4int producer, G4int eventId, G4double edep, G4double totalEnergy,
+              const std::vector<G4double>& energies,
+              const std::vector<RecordQueue::TypeId>& types,
+              const std::vector<G4double>& weights);
+    /// Drain the queue, join the I/O thread and close the writer;
+    /// all producers must have finished pushing
+    void Stop();
+
+    G4bool IsRunning() const { return fThread.joinable(); }
+    const VRecordWriter& GetWriter() const { return *fWriter; }
+    std::size_t GetNumberOfStalls() const { return fNofStalls.load(); }
+    std::size_t GetMaxPending() const { return fMaxPending; }
+
+  private:
+    void Run();
+    void Drain(G4bool& popped);
+    void EmitReady(G4bool all);
+    void Emit(std::deque<RecordQueue::Record>& pending);
+    void OpenWriter();
+
+    std::unique_ptr<VRecordWriter> fWriter;
+    RecordQueue fQueue;
+    std::thread fThread;
+    std::atomic<G4bool> fStopping{false};
+    std::atomic<std::size_t> fNofStalls{0};
+    // Records pushed and not yet emitted, in total and per producer
+    std::size_t fMaxHeld = 0;
+    std::atomic<std::size_t> fNofHeld{0};
+    std::unique_ptr<std::atomic<std::size_t>[]> fNofHeldBy;
+    std::size_t fNofProducers = 0;
+    G4String fSuffix;
+    G4bool fPrimarySet = false;
+    G4String fPrimaryName;
+    G4double fPrimaryEnergy = 0.;
+
+    // I/O thread only
+    std::vector<std::deque<RecordQueue::Record>> fPending;
+    std::vector<RecordQueue::Record> fFreeRecords;
+    RecordQueue::Record fRecord;
+    CaptureRecordBlock fBlock;
+    G4int fNextEventId = 0;
+    std::size_t fNofPending = 0;
+    std::size_t fMaxPending = 0;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
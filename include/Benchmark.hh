@@ -0,0 +1,99 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/Benchmark.hh
+/// \brief Definition of the GdNCap::Benchmark class
+
+#ifndef GdNCapBenchmark_h
+#define GdNCapBenchmark_h 1
+
+#include "ChildProcess.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+/// End-to-end benchmark (option -B, build target bench). Each workload
+/// macro runs in a ChildProcess of this executable with 1, 2, 4, ... up to
+/// the given number of threads, in bench_<workload>_<threads>/, where the
+/// workload is the macro name without "bench_" and ".mac". The results go
+/// to a JSON file, per workload and thread count:
+///   initTime        - initialization and first run initialization, s
+///   eventsPerSecond - of the last run of the macro, the measured one
+///   efficiency      - eventsPerSecond over threads times the one of the
+///                     single thread
+///   peakRSS         - peak resident memory of the job, MB
+///   outputBytes     - size of the files the job wrote, but its log
+/// along with the Geant4 version, host and arguments, to be compared
+/// across versions on the same machine.
+
+namespace GdNCap
+{
+
+class Benchmark
+{
+  public:
+    /// The arguments are passed on to every child, before the macro
+    Benchmark(const G4String& program, const std::vector<G4String>& macros,
+              const std::vector<G4String>& arguments);
+    ~Benchmark() = default;
+
+    /// Run all workloads and write the results; false if any child failed
+    G4bool Run(G4int maxThreads, const G4String& fileName);
+
+  private:
+    struct Measurement
+    {
+      G4int fNofThreads = 0;
+      G4bool fSucceeded = false;
+      G4double fInitTime = 0.;
+      G4int fNofEvents = 0;
+      G4double fEventTime = 0.;
+      G4double fEventsPerSecond = 0.;
+      G4double fEfficiency = 0.;
+      G4double fPeakMemory = 0.;   // MB
+      std::uint64_t fOutputSize = 0;
+    };
+    struct Workload
+    {
+      G4String fName;
+      G4String fMacro;
+      std::vector<Measurement> fMeasurements;
+    };
+
+    static std::uint64_t GetOutputSize(const G4String& directory);
+    void Write(const G4String& fileName, const std::vector<Workload>& workloads) const;
+
+    ChildProcess fChild;
+    std::vector<G4String> fMacros;
+    std::vector<G4String> fArguments;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,121 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/BiasingOperator.hh
+/// \brief Definition of the GdNCap::BiasingOperator class
+
+#ifndef GdNCapBiasingOperator_h
+#define GdNCapBiasingOperator_h 1
+
+#include "G4VBiasingOperator.hh"
+#include "globals.hh"
+
+#include "DetectorConstruction.hh"
+
+#include <map>
+
+class G4BOptrForceCollision;
+class G4BOptnChangeCrossSection;
+class G4BOptnCloning;
+class G4ParticleDefinition;
+
+/// Generic biasing operator of the neutrons in the scoring volume, in the
+/// mode set on the DetectorConstruction at the time of each step:
+///
+///   forceCollision  - delegates to a G4BOptrForceCollision for neutrons
+///   implicitCapture - sets the cross section of the capture processes
+///                     (CaptureFilter) to zero; the weight of the neutron
+///                     is multiplied by the analog non-capture probability
+///                     at every step, as in example GB01; below a
+///                     threshold it plays Russian roulette (RouletteOperation)
+///   splitting       - clones a neutron into two halves of its weight
+///                     each time it reaches a depth cell deeper than any
+///                     it has been in; the clones carry the cell on
+///
+/// One operator is constructed per thread by ConstructSDandField().
+
+namespace GdNCap
+{
+
+class CaptureFilter;
+class RouletteOperation;
+
+class BiasingOperator : public G4VBiasingOperator
+{
+  public:
+    BiasingOperator(const DetectorConstruction* detConstruction);
+    ~BiasingOperator() override;
+
+    void StartRun() override;
+    void StartTracking(const G4Track* track) override;
+
+    const RouletteOperation* GetRoulette() const { return fRoulette; }
+
+  private:
+    G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+      const G4Track* track, const G4BiasingProcessInterface* callingProcess) override;
+    G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+      const G4Track* track, const G4BiasingProcessInterface* callingProcess) override;
+    G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+      const G4Track* track, const G4BiasingProcessInterface* callingProcess) override;
+
+    using G4VBiasingOperator::OperationApplied;
+    void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                          G4BiasingAppliedCase biasingCase,
+                          G4VBiasingOperation* operationApplied,
+                          const G4VParticleChange* particleChangeProduced) override;
+    void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                          G4BiasingAppliedCase biasingCase,
+                          G4VBiasingOperation* occurenceOperationApplied,
+                          G4double weightForOccurenceInteraction,
+                          G4VBiasingOperation* finalStateOperationApplied,
+                          const G4VParticleChange* particleChangeProduced) override;
+    void ExitBiasing(const G4Track* track,
+                     const G4BiasingProcessInterface* callingProcess) override;
+
+    /// True for neutrons in the given mode
+    G4bool Biases(DetectorConstruction::BiasingMode mode, const G4Track* track) const;
+
+    const DetectorConstruction* fDetConstruction = nullptr;
+    const CaptureFilter* fCaptureFilter = nullptr;
+    const G4ParticleDefinition* fNeutron = nullptr;
+
+    // Registered with the biasing framework like this operator, which
+    // keeps it until the end of the job
+    G4BOptrForceCollision* fForceCollision = nullptr;
+    std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*> fImplicitCaptures;
+    G4BOptnCloning* fCloning = nullptr;
+    RouletteOperation* fRoulette = nullptr;
+    // Deepest splitting cell of the current track, -1 before it is seen
+    // in the scoring volume
+    G4int fCell = -1;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
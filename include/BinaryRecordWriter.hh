@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/BinaryRecordWriter.hh
+/// \brief Definition of the GdNCap::BinaryRecordWriter class
+
+#ifndef GdNCapBinaryRecordWriter_h
+#define GdNCapBinaryRecordWriter_h 1
+
+#include "VRecordWriter.hh"
+
+#include <cstdint>
+#include <fstream>
+
+/// Writer of capture records in the binary columnar format described in
+/// CaptureRecordFormat.hh, to CaptureRecords<suffix>.gdnc.
+///
+/// Events are buffered column-wise and written in blocks of
+/// kEventsPerBlock events, each optionally compressed with zlib.
+/// Compression is only available when built with GDNCAP_USE_ZLIB.
+
+namespace GdNCap
+{
+
+class BinaryRecordWriter : public VRecordWriter
+{
+  public:
+    static constexpr std::size_t kEventsPerBlock = 65536;
+
+    /// compressionLevel 0 stores the blocks uncompressed, 1-9 are zlib levels
+    explicit BinaryRecordWriter(G4int compressionLevel = 0);
+    ~BinaryRecordWriter() override;
+
+    using VRecordWriter::Write;
+    void Open(const G4String& suffix = "") override;
+    void Write(const CaptureRecordView::Event& event) override;
+    void Close() override;
+    G4bool IsOpen() const override { return fFile.is_open(); }
+    std::vector<G4String> GetFileNames(const G4String& suffix = "") const override;
+
+    static G4String GetFileName(const G4String& suffix = "");
+
+  private:
+    void WriteBlock();
+
+    G4int fCompressionLevel;
+    std::ofstream fFile;
+    std::uint64_t fNofBlocks = 0;
+
+    // Columns of the block being filled
+    std::vector<std::int32_t> fEventId;
+    std::vector<G4double> fEdep;
+    std::vector<G4double> fTotalEnergy;
+    std::vector<std::uint32_t> fMultiplicity;
+    std::vector<G4double> fEnergy;
+    std::vector<std::uint8_t> fType;
+    std::vector<G4double> fWeight;
+
+    std::vector<char> fRaw;
+    std::vector<char> fCompressed;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
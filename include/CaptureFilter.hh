@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CaptureFilter.hh
+/// \brief Definition of the GdNCap::CaptureFilter class
+
+#ifndef GdNCapCaptureFilter_h
+#define GdNCapCaptureFilter_h 1
+
+#include "globals.hh"
+#include "ParticleTypeTable.hh"
+
+#include <utility>
+#include <vector>
+
+class G4ParticleDefinition;
+class G4VProcess;
+
+/// Selects the secondaries recorded as capture products: those created by
+/// one of the configured processes (default "nCapture") with one of the
+/// configured particles (default "gamma" and "e-").
+///
+/// The names are resolved by Resolve() at the start of each run, on each
+/// thread, into that thread's G4VProcess instances and the particle
+/// definitions with their interned type IDs, so the per-step checks only
+/// compare pointers. The name-based checks of the original stepping action
+/// are kept for comparison (see CaptureFilterMessenger).
+///
+/// The filter also holds the transport mode applied by StackingAction to
+/// the secondaries once the capture products have been recorded. Except
+/// in the "full" mode, the energy deposit is not scored.
+
+namespace GdNCap
+{
+
+class CaptureFilterMessenger;
+
+class CaptureFilter
+{
+  public:
+    using TypeId = ParticleTypeTable::TypeId;
+    enum class Transport { Full, KillSecondaries, CaptureGammas };
+
+    CaptureFilter();
+    ~CaptureFilter();
+
+    void SetProcessNames(const std::vector<G4String>& names) { fProcessNames = names; }
+    void SetParticleNames(const std::vector<G4String>& names) { fParticleNames = names; }
+    void SetStringMatch(G4bool stringMatch) { fStringMatch = stringMatch; }
+    G4bool UsesStringMatch() const { return fStringMatch; }
+    void SetTransport(Transport transport) { fTransport = transport; }
+    Transport GetTransport() const { return fTransport; }
+    /// False if secondaries are killed, so the energy deposit is incomplete
+    G4bool ScoresEdep() const { return fTransport == Transport::Full; }
+
+    /// Look up this thread's processes and the particle definitions
+    void Resolve();
+
+    inline G4bool IsCaptureProcess(const G4VProcess* process) const;
+    /// True if the particle is recorded, with its type ID
+    inline G4bool IsRecorded(const G4ParticleDefinition* particle, TypeId& type) const;
+
+    // Name-based checks, for comparison only
+    G4bool IsCaptureProcessName(const G4String& name) const;
+    G4bool IsRecordedParticleName(const G4String& name) const;
+
+  private:
+    std::vector<G4String> fProcessNames = { "nCapture" };
+    std::vector<G4String> fParticleNames = { "gamma", "e-" };
+    G4bool fStringMatch = false;
+    Transport fTransport = Transport::Full;
+
+    std::vector<const G4VProcess*> fProcesses;
+    std::vector<std::pair<const G4ParticleDefinition*, TypeId>> fParticles;
+
+    CaptureFilterMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4bool CaptureFilter::IsCaptureProcess(const G4VProcess* process) const
+{
+  for (auto captureProcess : fProcesses) {
+    if (process == captureProcess) return true;
+  }
+  return false;
+}
+
+inline G4bool CaptureFilter::IsRecorded(const G4ParticleDefinition* particle,
+                                        TypeId& type) const
+{
+  for (const auto& [definition, typeId] : fParticles) {
+    if (particle == definition) {
+      type = typeId;
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
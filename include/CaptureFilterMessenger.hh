@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CaptureFilterMessenger.hh
+/// \brief Definition of the GdNCap::CaptureFilterMessenger class
+
+#ifndef GdNCapCaptureFilterMessenger_h
+#define GdNCapCaptureFilterMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+
+/// Messenger selecting the processes and particles recorded by
+/// CaptureFilter, and the transport of the secondaries. One instance lives with each thread's filter; the
+/// commands are broadcast and take effect at the next run.
+
+namespace GdNCap
+{
+
+class CaptureFilter;
+
+class CaptureFilterMessenger : public G4UImessenger
+{
+  public:
+    CaptureFilterMessenger(CaptureFilter* filter);
+    ~CaptureFilterMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    CaptureFilter* fFilter = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithAString* fProcessesCmd = nullptr;
+    G4UIcmdWithAString* fParticlesCmd = nullptr;
+    G4UIcmdWithABool* fStringMatchCmd = nullptr;
+    G4UIcmdWithAString* fTransportCmd = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
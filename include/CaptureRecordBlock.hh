@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CaptureRecordBlock.hh
+/// \brief Definition of the GdNCap::CaptureRecordBlock class
+
+#ifndef GdNCapCaptureRecordBlock_h
+#define GdNCapCaptureRecordBlock_h 1
+
+#include "globals.hh"
+#include "ParticleTypeTable.hh"
+
+#include <cstdint>
+#include <vector>
+
+/// A fixed-capacity block of per-event capture records kept as columns.
+///
+/// Per event: the event ID, the energy deposit in the scoring volume, the
+/// summed energy of the recorded secondaries and an offset into the
+/// per-secondary columns. Per secondary: its kinetic energy, its
+/// interned particle type and its statistical weight (1 without
+/// biasing). A block never holds more than its capacity in events, so
+/// blocks can be handed between threads and spliced into another store
+/// without touching the records themselves.
+
+namespace GdNCap
+{
+
+class CaptureRecordBlock
+{
+  public:
+    using TypeId = ParticleTypeTable::TypeId;
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    explicit CaptureRecordBlock(std::size_t capacity = kDefaultCapacity);
+    ~CaptureRecordBlock() = default;
+
+    void AddEvent(G4int eventId, G4double edep, G4double totalEnergy,
+                  const std::vector<G4double>& energies,
+                  const std::vector<TypeId>& types,
+                  const std::vector<G4double>& weights);
+    void Clear();
+
+    std::size_t GetCapacity() const { return fCapacity; }
+    std::size_t GetNumberOfEvents() const { return fTotalEnergy.size(); }
+    std::size_t GetNumberOfSecondaries() const { return fEnergy.size(); }
+    G4bool IsFull() const { return GetNumberOfEvents() >= fCapacity; }
+    G4bool IsEmpty() const { return fTotalEnergy.empty(); }
+    G4bool IsSorted() const { return fSorted; }
+    G4int GetFirstEventId() const { return fEventId.front(); }
+    G4int GetLastEventId() const { return fEventId.back(); }
+    /// Bytes allocated by the block
+    std::size_t GetMemoryUsage() const;
+
+    /// Copy of this block with the events in increasing event ID order
+    CaptureRecordBlock SortedByEventId() const;
+
+    // Column access
+    G4int GetEventId(std::size_t event) const { return fEventId[event]; }
+    G4double GetEdep(std::size_t event) const { return fEdep[event]; }
+    G4double GetTotalEnergy(std::size_t event) const { return fTotalEnergy[event]; }
+    std::size_t GetFirstSecondary(std::size_t event) const { return fOffset[event]; }
+    std::size_t GetNumberOfSecondaries(std::size_t event) const
+      { return fOffset[event + 1] - fOffset[event]; }
+    const G4double* GetEnergies() const { return fEnergy.data(); }
+    const TypeId* GetTypes() const { return fType.data(); }
+    const G4double* GetWeights() const { return fWeight.data(); }
+
+  private:
+    std::size_t fCapacity;
+    G4bool fSorted = true;
+    std::vector<G4int> fEventId;
+    std::vector<G4double> fEdep;
+    std::vector<G4double> fTotalEnergy;
+    std::vector<std::uint32_t> fOffset;
+    std::vector<G4double> fEnergy;
+    std::vector<TypeId> fType;
+    std::vector<G4double> fWeight;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,118 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CaptureRecordFormat.hh
+/// \brief Definition of the binary capture record file format
+
+#ifndef GdNCapCaptureRecordFormat_h
+#define GdNCapCaptureRecordFormat_h 1
+
+#include <cstdint>
+
+/// Layout of CaptureRecords<suffix>.gdnc, written by BinaryRecordWriter and
+/// read by the GdNCapReader library. All values in native (little-endian)
+/// byte order, energies in MeV.
+///
+///   FileHeader
+///   primary particle name           FileHeader::fPrimaryNameLength bytes
+///   { BlockHeader, payload }...     payload is BlockHeader::fStoredSize bytes,
+///                                   zlib-compressed if fCompression == kZlib
+///   type table                      uint32 nofTypes,
+///                                   { uint32 length, name bytes }...
+///   Footer                          last sizeof(Footer) bytes of the file
+///
+/// The uncompressed payload of a block with nE events and nS secondaries
+/// holds the columns back to back:
+///   int32 eventId[nE]  float64 edep[nE]  float64 totalEnergy[nE]
+///   uint32 multiplicity[nE]  float64 energy[nS]  uint8 type[nS]
+///   float64 weight[nS]              since version 2
+/// Events are in increasing event ID order within a file; type[] indexes
+/// the type table. edep is NaN when the secondaries were not transported.
+/// weight is the statistical weight of the secondary, 1 without biasing;
+/// version 1 files have no weight column.
+///
+/// This header does not depend on Geant4.
+
+namespace GdNCap
+{
+namespace RecordFormat
+{
+
+constexpr char kFileMagic[9] = "GDNCBIN1";
+constexpr char kBlockMagic[5] = "BLK1";
+constexpr char kFooterMagic[9] = "GDNCEND1";
+constexpr std::uint32_t kVersion = 2;
+
+enum Compression : std::uint32_t { kNone = 0, kZlib = 1 };
+
+struct FileHeader
+{
+  char fMagic[8];
+  std::uint32_t fVersion;
+  std::uint32_t fPrimaryNameLength;
+  double fPrimaryEnergy;
+  std::uint64_t fReserved;
+};
+
+struct BlockHeader
+{
+  char fMagic[4];
+  std::uint32_t fNofEvents;
+  std::uint32_t fNofSecondaries;
+  std::uint32_t fCompression;
+  std::uint64_t fRawSize;
+  std::uint64_t fStoredSize;
+};
+
+struct Footer
+{
+  char fMagic[8];
+  std::uint64_t fNofEvents;
+  std::uint64_t fNofSecondaries;
+  std::uint64_t fNofBlocks;
+  std::uint64_t fTypeTableOffset;
+};
+
+static_assert(sizeof(FileHeader) == 32, "unexpected padding in FileHeader");
+static_assert(sizeof(BlockHeader) == 32, "unexpected padding in BlockHeader");
+static_assert(sizeof(Footer) == 40, "unexpected padding in Footer");
+
+/// Size of the uncompressed payload of a block
+inline std::uint64_t GetRawSize(std::uint64_t nofEvents, std::uint64_t nofSecondaries,
+                                std::uint32_t version = kVersion)
+{
+  const std::uint64_t secondarySize = sizeof(double) + sizeof(std::uint8_t)
+                                    + (version >= 2 ? sizeof(double) : 0);
+  return nofEvents * (sizeof(std::int32_t) + 2 * sizeof(double) + sizeof(std::uint32_t))
+       + nofSecondaries * secondarySize;
+}
+
+}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
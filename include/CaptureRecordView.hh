@@ -0,0 +1,136 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CaptureRecordView.hh
+/// \brief Definition of the GdNCap::CaptureRecordView class
+
+#ifndef GdNCapCaptureRecordView_h
+#define GdNCapCaptureRecordView_h 1
+
+#include "CaptureRecordBlock.hh"
+
+#include <vector>
+
+/// Read-only view over the capture records held by an Accumulable.
+///
+/// The records are organised in sequences of blocks, each sequence in
+/// increasing event ID order (typically one per worker thread). Iterating
+/// the view merges the sequences by event ID, so the order of the events
+/// does not depend on which thread processed them or when it was merged.
+///
+/// The view only references the blocks of the store it was taken from;
+/// it must not outlive that store or be used across a Reset().
+
+namespace GdNCap
+{
+
+class CaptureRecordView
+{
+  public:
+    using TypeId = CaptureRecordBlock::TypeId;
+    using Sequence = std::vector<const CaptureRecordBlock*>;
+
+    /// Records of a single event
+    class Event
+    {
+      public:
+        Event() = default;
+        Event(const CaptureRecordBlock* block, std::size_t row)
+        : fBlock(block), fRow(row), fFirst(block->GetFirstSecondary(row)) {}
+
+        G4int GetEventId() const { return fBlock->GetEventId(fRow); }
+        G4double GetEdep() const { return fBlock->GetEdep(fRow); }
+        G4double GetTotalEnergy() const { return fBlock->GetTotalEnergy(fRow); }
+        std::size_t GetNumberOfSecondaries() const
+          { return fBlock->GetNumberOfSecondaries(fRow); }
+        G4double GetEnergy(std::size_t i) const
+          { return fBlock->GetEnergies()[fFirst + i]; }
+        TypeId GetType(std::size_t i) const
+          { return fBlock->GetTypes()[fFirst + i]; }
+        G4double GetWeight(std::size_t i) const
+          { return fBlock->GetWeights()[fFirst + i]; }
+        const G4String& GetTypeName(std::size_t i) const
+          { return ParticleTypeTable::Instance()->GetName(GetType(i)); }
+
+      private:
+        const CaptureRecordBlock* fBlock = nullptr;
+        std::size_t fRow = 0;
+        std::size_t fFirst = 0;
+    };
+
+    /// Forward cursor visiting the events in increasing event ID order
+    class Cursor
+    {
+      public:
+        explicit Cursor(const CaptureRecordView& view);
+
+        G4bool Next(Event& event);
+
+      private:
+        struct Position
+        {
+          G4int fEventId;
+          std::size_t fSequence;
+          std::size_t fBlock;
+          std::size_t fRow;
+        };
+        void Push(std::size_t sequence, std::size_t block, std::size_t row);
+
+        const CaptureRecordView& fView;
+        std::vector<Position> fHeap;
+    };
+
+    CaptureRecordView() = default;
+    explicit CaptureRecordView(std::vector<Sequence> sequences)
+    : fSequences(std::move(sequences)) {}
+
+    std::size_t GetNumberOfEvents() const;
+    std::size_t GetNumberOfSecondaries() const;
+    G4bool IsEmpty() const { return GetNumberOfEvents() == 0; }
+
+    /// Call f(const Event&) for each stored event, in event ID order
+    template <typename F>
+    void ForEachEvent(F&& f) const;
+
+  private:
+    std::vector<Sequence> fSequences;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename F>
+void CaptureRecordView::ForEachEvent(F&& f) const
+{
+  Cursor cursor(*this);
+  Event event;
+  while (cursor.Next(event)) f(event);
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
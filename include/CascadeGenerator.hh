@@ -0,0 +1,68 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CascadeGenerator.hh
+/// \brief Definition of the GdNCap::CascadeGenerator class
+
+#ifndef GdNCapCascadeGenerator_h
+#define GdNCapCascadeGenerator_h 1
+
+#include "G4VPrimaryGenerator.hh"
+#include "globals.hh"
+
+class G4ParticleDefinition;
+
+/// Primary generator replaying capture-gamma cascades from a
+/// CascadeLibrary: each vertex holds all the gammas of one cascade drawn
+/// from the library, each in an isotropic direction, at the position set
+/// with SetParticlePosition(). No neutron is transported.
+
+namespace GdNCap
+{
+
+class CascadeLibrary;
+
+class CascadeGenerator : public G4VPrimaryGenerator
+{
+  public:
+    CascadeGenerator();
+    ~CascadeGenerator() override = default;
+
+    void SetLibrary(const CascadeLibrary* library) { fLibrary = library; }
+    const CascadeLibrary* GetLibrary() const { return fLibrary; }
+
+    void GeneratePrimaryVertex(G4Event* event) override;
+
+  private:
+    const CascadeLibrary* fLibrary = nullptr;
+    const G4ParticleDefinition* fGamma = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
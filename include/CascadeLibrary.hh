@@ -0,0 +1,112 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CascadeLibrary.hh
+/// \brief Definition of the GdNCap::CascadeLibrary class
+
+#ifndef GdNCapCascadeLibrary_h
+#define GdNCapCascadeLibrary_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+/// Library of sampled capture-gamma cascades, keyed by the target isotope.
+///
+/// While it is built, each thread adds the gammas of every capture to its
+/// instance, up to a maximum number of cascades per isotope, and the
+/// instances are merged on the master, which writes the library to a file
+/// (see CascadeLibraryFormat.hh). The gamma energies of a cascade are kept
+/// contiguous.
+///
+/// For replay, the master reads a library file once and shares it
+/// read-only with the workers' CascadeGenerator; Sample() then draws a
+/// cascade of the selected isotopes.
+
+namespace GdNCap
+{
+
+class CascadeLibrary : public G4VAccumulable
+{
+  public:
+    struct Isotope
+    {
+      G4int fZ = 0;
+      G4int fA = 0;
+      G4long fNofCaptures = 0;
+      std::vector<std::uint32_t> fFirst = { 0 };
+      std::vector<float> fEnergies;
+
+      std::size_t GetNumberOfCascades() const { return fFirst.size() - 1; }
+    };
+
+    struct Cascade
+    {
+      const float* fEnergies = nullptr;
+      std::size_t fNofGammas = 0;
+    };
+
+    CascadeLibrary() = default;
+    ~CascadeLibrary() override = default;
+
+    void Merge(const G4VAccumulable& other) final;
+    void Reset() final;
+
+    /// Maximum number of cascades stored per isotope, 0 for no limit
+    void SetMaxCascades(G4long maxCascades) { fMaxCascades = maxCascades; }
+    /// Add the gamma energies [MeV] of one capture on the isotope (Z, A)
+    void AddCascade(G4int Z, G4int A, const std::vector<G4double>& energies);
+
+    G4bool Write(const G4String& fileName) const;
+    G4bool Read(const G4String& fileName);
+
+    /// Replay cascades of the isotope (Z, A) only, or of all isotopes in
+    /// their capture proportions if Z is 0; false if there is none
+    G4bool Select(G4int Z, G4int A);
+    /// Cascade drawn with the uniform random numbers u1 and u2
+    Cascade Sample(G4double u1, G4double u2) const;
+
+    const std::vector<Isotope>& GetIsotopes() const { return fIsotopes; }
+    G4bool IsEmpty() const { return fIsotopes.empty(); }
+    /// Bytes allocated by the stored cascades
+    std::size_t GetMemoryUsage() const;
+
+  private:
+    Isotope& FindOrAdd(G4int Z, G4int A);
+
+    G4long fMaxCascades = 0;
+    std::vector<Isotope> fIsotopes;
+    // Selected isotopes with their cumulative capture fractions
+    std::vector<std::pair<const Isotope*, G4double>> fSelection;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/CascadeLibraryFormat.hh
+/// \brief Definition of the binary capture-cascade library format
+
+#ifndef GdNCapCascadeLibraryFormat_h
+#define GdNCapCascadeLibraryFormat_h 1
+
+#include <cstdint>
+
+/// Layout of the cascade library files written and read by CascadeLibrary.
+/// All values in native (little-endian) byte order, energies in MeV.
+///
+///   FileHeader
+///   IsotopeEntry[fNofIsotopes]
+///   for each isotope, at IsotopeEntry::fOffset from the start of the file:
+///     uint32  first[nofCascades + 1]   index of the first gamma of each
+///                                      cascade, the last entry is nofGammas
+///     float32 energy[nofGammas]        gamma energies, cascade by cascade
+///
+/// fNofCaptures counts all the captures on the isotope seen while building,
+/// including those beyond the stored cascades, so that the isotopes can be
+/// replayed in their capture proportions.
+///
+/// This header does not depend on Geant4.
+
+namespace GdNCap
+{
+namespace CascadeFormat
+{
+
+constexpr char kFileMagic[9] = "GDNCCAS1";
+constexpr std::uint32_t kVersion = 1;
+
+struct FileHeader
+{
+  char fMagic[8];
+  std::uint32_t fVersion;
+  std::uint32_t fNofIsotopes;
+};
+
+struct IsotopeEntry
+{
+  std::uint32_t fZ;
+  std::uint32_t fA;
+  std::uint64_t fNofCaptures;
+  std::uint64_t fNofCascades;
+  std::uint64_t fNofGammas;
+  std::uint64_t fOffset;
+};
+
+static_assert(sizeof(FileHeader) == 16, "unexpected padding in FileHeader");
+static_assert(sizeof(IsotopeEntry) == 40, "unexpected padding in IsotopeEntry");
+
+}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/ChildProcess.hh
+/// \brief Definition of the GdNCap::ChildProcess class
+
+#ifndef GdNCapChildProcess_h
+#define GdNCapChildProcess_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Runs a program, in practice this executable with other options, in a
+/// child process in its own directory, with its output to log.txt there;
+/// used where a setting is fixed for the lifetime of a process, e.g. by
+/// PhysicsListComparison and Benchmark. Needs POSIX fork(); elsewhere Run()
+/// warns and fails.
+
+namespace GdNCap
+{
+
+class ChildProcess
+{
+  public:
+    /// A program without a directory is looked up in the PATH
+    explicit ChildProcess(const G4String& program);
+    ~ChildProcess() = default;
+
+    /// Run in directory, created if needed; false if the child could not
+    /// be started or did not exit with 0
+    G4bool Run(const std::vector<G4String>& arguments, const G4String& directory);
+
+    /// Peak resident memory of the last child, in MB
+    G4double GetPeakMemory() const { return fPeakMemory; }
+
+    /// Absolute path of an existing file, for the arguments of a child
+    static G4String GetAbsolutePath(const G4String& path);
+
+  private:
+    G4String fProgram;
+    G4double fPeakMemory = 0.;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -31,28 +31,115 @@
 #define GdNCapDetectorConstruction_h 1
 
 #include "G4VUserDetectorConstruction.hh"
+#include "G4ThreeVector.hh"
 #include "globals.hh"
 
 class G4VPhysicalVolume;
 class G4LogicalVolume;
+class G4VTouchable;
 
 /// Detector construction class to define materials and geometry.
+///
+/// In the "sd" scoring mode an EnvelopeSD is attached to the scoring
+/// volume; in the default "stepping" mode the SteppingAction scores.
+///
+/// When the physics list has generic biasing for neutrons (option -b), a
+/// BiasingOperator is attached to the scoring volume; its mode is chosen
+/// per run with /GdNCap/biasing/ (see DetectorMessenger).
+///
+/// The materials are defined once, the geometry is built from the
+/// envelope parameters at every Construct(). Changing them after the
+/// initialization rebuilds the geometry at the next run through
+/// /run/reinitializeGeometry, keeping the physics and the HP data loaded
+/// for the elements of all defined materials.
 
 namespace GdNCap
 {
 
+class DetectorMessenger;
+class BiasingOperator;
+
 class DetectorConstruction : public G4VUserDetectorConstruction
 {
   public:
-    DetectorConstruction() = default;
-    ~DetectorConstruction() override = default;
+    enum class ScoringMode { Stepping, SensitiveDetector };
+    enum class BiasingMode { None, ForceCollision, ImplicitCapture, Splitting };
+
+    DetectorConstruction();
+    ~DetectorConstruction() override;
 
     G4VPhysicalVolume* Construct() override;
+    void ConstructSDandField() override;
 
     G4LogicalVolume* GetScoringVolume() const { return fScoringVolume; }
+    /// Depth of a point of the scoring volume behind its upstream (-z)
+    /// face; the touchable locates the volume's placement
+    G4double GetDepth(const G4VTouchable* touchable, const G4ThreeVector& position) const;
+    /// Extent of the scoring volume along z
+    G4double GetThickness() const;
+
+    /// Has to be set before the user actions are built
+    void SetScoringMode(ScoringMode mode) { fScoringMode = mode; }
+    ScoringMode GetScoringMode() const { return fScoringMode; }
+
+    /// Has to be set before initialization, together with the biasing
+    /// physics
+    void SetBiasing(G4bool biasing) { fBiasing = biasing; }
+    G4bool HasBiasing() const { return fBiasing; }
+    void SetBiasingMode(BiasingMode mode);
+    BiasingMode GetBiasingMode() const { return fBiasingMode; }
+    G4bool IsBiased() const { return fBiasingMode != BiasingMode::None; }
+    /// Name of the biasing mode, as in /GdNCap/biasing/mode
+    G4String GetBiasingModeName() const;
+    void SetSplitLength(G4double length) { fSplitLength = length; }
+    G4double GetSplitLength() const { return fSplitLength; }
+    /// Russian roulette of the implicit capture below the threshold weight,
+    /// 0 for none; survival <= 0 stands for twice the threshold
+    void SetRouletteWeights(G4double threshold, G4double survival);
+    G4double GetRouletteThreshold() const { return fRouletteThreshold; }
+    G4double GetRouletteSurvival() const { return fRouletteSurvival; }
+    /// Biasing operator of the calling thread, nullptr before
+    /// ConstructSDandField() or without the biasing physics
+    const BiasingOperator* GetBiasingOperator() const;
+
+    /// Define a NIST material the job uses, e.g. G4_Gd, so that its data is
+    /// loaded with the physics tables; false, with a warning, if unknown.
+    /// After the initialization the physics tables are rebuilt at the next
+    /// run, so name the materials before /run/initialize.
+    G4bool AddMaterial(const G4String& name);
+
+    /// Envelope parameters; true if the value changed. An unknown material
+    /// is rejected with a warning.
+    G4bool SetEnvelopeSizeXY(G4double size);
+    G4bool SetEnvelopeThickness(G4double thickness);
+    G4bool SetEnvelopeMaterial(const G4String& name);
+    G4double GetEnvelopeSizeXY() const { return fEnvSizeXY; }
+    G4double GetEnvelopeThickness() const { return fEnvSizeZ; }
+    const G4String& GetEnvelopeMaterial() const { return fEnvMaterial; }
+
+    /// Diagnostics of the construction, off for production jobs
+    void SetCheckOverlaps(G4bool check) { fCheckOverlaps = check; }
+    void SetPrintMaterials(G4bool print) { fPrintMaterials = print; }
 
   protected:
     G4LogicalVolume* fScoringVolume = nullptr;
+    ScoringMode fScoringMode = ScoringMode::Stepping;
+
+  private:
+    void DefineMaterials();
+
+    DetectorMessenger* fMessenger = nullptr;
+    G4bool fBiasing = false;
+    BiasingMode fBiasingMode = BiasingMode::None;
+    G4double fSplitLength = 0.;
+    G4double fRouletteThreshold = 0.25;
+    G4double fRouletteSurvival = 0.5;
+    G4bool fCheckOverlaps = false;
+    G4bool fPrintMaterials = false;
+    G4bool fMaterialsDefined = false;
+    G4double fEnvSizeXY = 0.;
+    G4double fEnvSizeZ = 0.;
+    G4String fEnvMaterial = "myGd157";
 };
 
 }
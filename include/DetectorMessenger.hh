@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/DetectorMessenger.hh
+/// \brief Definition of the GdNCap::DetectorMessenger class
+
+#ifndef GdNCapDetectorMessenger_h
+#define GdNCapDetectorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+/// Messenger of the DetectorConstruction. It lives on the master only and
+/// its commands are not broadcast; the workers' biasing operators read
+/// the settings at each step, so they take effect at the next run.
+///
+/// A change of the envelope after the initialization applies
+/// /run/reinitializeGeometry, so the geometry is rebuilt at the next run.
+
+namespace GdNCap
+{
+
+class DetectorConstruction;
+
+class DetectorMessenger : public G4UImessenger
+{
+  public:
+    DetectorMessenger(DetectorConstruction* detConstruction);
+    ~DetectorMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+    G4String GetCurrentValue(G4UIcommand* command) override;
+
+  private:
+    void ReinitializeGeometry();
+
+    DetectorConstruction* fDetConstruction = nullptr;
+
+    G4UIdirectory* fBiasingDirectory = nullptr;
+    G4UIcmdWithAString* fBiasingModeCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSplitLengthCmd = nullptr;
+    G4UIcommand* fRouletteCmd = nullptr;
+
+    G4UIdirectory* fDetectorDirectory = nullptr;
+    G4UIcmdWithABool* fCheckOverlapsCmd = nullptr;
+    G4UIcmdWithABool* fPrintMaterialsCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSizeXYCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fThicknessCmd = nullptr;
+    G4UIcmdWithAString* fMaterialCmd = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,65 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/EnvelopeSD.hh
+/// \brief Definition of the GdNCap::EnvelopeSD class
+
+#ifndef GdNCapEnvelopeSD_h
+#define GdNCapEnvelopeSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+/// Sensitive detector of the Envelope (the scoring volume) used in the
+/// "sd" scoring mode. It sums the weighted energy deposit of the event's
+/// steps in the envelope and hands it to the EventAction at the end of
+/// event, so no user stepping action runs on steps elsewhere in the world.
+/// The neutron steps are also passed on for the transmission tally.
+
+namespace GdNCap
+{
+
+class EventAction;
+
+class EnvelopeSD : public G4VSensitiveDetector
+{
+  public:
+    EnvelopeSD(const G4String& name);
+    ~EnvelopeSD() override = default;
+
+    void Initialize(G4HCofThisEvent* hitCollection) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+    void EndOfEvent(G4HCofThisEvent* hitCollection) override;
+
+  private:
+    EventAction* fEventAction = nullptr;
+    G4double fEdep = 0.;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -33,15 +33,32 @@
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
+#include "ParticleTypeTable.hh"
+
+#include <chrono>
 #include <vector>
 
+class G4VProcess;
+class G4Step;
+class G4ParticleDefinition;
+
 /// Event action class
 ///
+/// Besides the capture records, it tallies the weighted capture yield and
+/// the transmission of neutrons through the downstream face of the
+/// scoring volume; the run action estimates their errors and figures of
+/// merit from the per-event values.
+///
+/// Each event is timed from the begin to the end of the event action, in
+/// wall and thread CPU time, and the time spent in the event action itself
+/// is counted as user action time (see WorkerTelemetry).
 
 namespace GdNCap
 {
 
 class RunAction;
+class CascadeLibrary;
+class DetectorConstruction;
 
 class EventAction : public G4UserEventAction
 {
@@ -54,13 +71,49 @@ class EventAction : public G4UserEventAction
 
     void AddEdep(G4double edep) { fEdep += edep; }
     void AddSecE(G4double secE) { fSecE += secE; }
-    void PushSecondary(std::pair<G4double, G4String> fSecondary);
+    void PushSecondary(G4double energy, const G4String& name, G4double weight);
+    void PushSecondary(G4double energy, ParticleTypeTable::TypeId type, G4double weight)
+      { fSecEnergy.push_back(energy); fSecType.push_back(type); fSecWeight.push_back(weight); }
+    void CountStep() { ++fNofSteps; }
+    /// Tally a capture of the given weight at the given depth
+    void AddCapture(G4double weight, G4double depth);
+    /// Fill the capture histograms with the products pushed since the
+    /// previous capture, after those of a capture are pushed
+    void EndCapture();
+    /// Tally the neutron steps in the scoring volume: the capture expected
+    /// with implicit capture and the transmission
+    void ScoreNeutronStep(const G4Step* step);
+    const DetectorConstruction* GetDetectorConstruction() const { return fDetConstruction; }
+
+    /// True while a cascade library is built
+    G4bool BuildsCascades() const { return fCascadeLibrary != nullptr; }
+    /// Add the gamma energies [MeV] of a capture by this process to the
+    /// library, keyed by the process' target isotope
+    void AddCascade(const G4VProcess* captureProcess, const std::vector<G4double>& energies);
 
   private:
+    using Clock = std::chrono::steady_clock;
+
+    void FillNtuples(const G4Event* event) const;
+
     RunAction* fRunAction = nullptr;
     G4double   fEdep = 0.;
     G4double   fSecE = 0.;
-    std::vector<std::pair<G4double,G4String>> fSecL;
+    G4long     fNofSteps = 0;
+    G4double   fCaptureYield = 0.;
+    G4double   fTransmission = 0.;
+    std::vector<G4double> fSecEnergy;
+    std::vector<ParticleTypeTable::TypeId> fSecType;
+    std::vector<G4double> fSecWeight;
+    // First product of the current capture
+    std::size_t fCaptureBegin = 0;
+    ParticleTypeTable::TypeId fGammaType = 0;
+    CascadeLibrary* fCascadeLibrary = nullptr;
+    const DetectorConstruction* fDetConstruction = nullptr;
+    const G4ParticleDefinition* fNeutron = nullptr;
+    Clock::time_point fEventStart;
+    G4double fEventCpuStart = 0.;
+    G4double fUserActionTime = 0.;
 };
 
 }
@@ -0,0 +1,70 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/EventModuloTuner.hh
+/// \brief Definition of the GdNCap::EventModuloTuner class
+
+#ifndef GdNCapEventModuloTuner_h
+#define GdNCapEventModuloTuner_h 1
+
+#include "globals.hh"
+
+/// Chooses the event modulo of the MT and tasking run managers, the number
+/// of events a worker takes at once, from short calibration runs
+/// (/GdNCap/run/tuneEventModulo). With events of about a millisecond the
+/// dispatch of single events costs a good part of the throughput, while
+/// large chunks leave threads idle at the end of a run.
+///
+/// Each candidate modulo runs the same number of events, after a first run
+/// that builds the physics tables and starts the workers; the records are
+/// not stored meanwhile (/GdNCap/output/mode none). The fastest modulo is
+/// kept for the following runs.
+///
+/// Created in main(), on the master only.
+
+namespace GdNCap
+{
+
+class EventModuloTunerMessenger;
+
+class EventModuloTuner
+{
+  public:
+    EventModuloTuner();
+    ~EventModuloTuner();
+
+    /// Run the calibration with nofEvents per candidate
+    void Tune(G4int nofEvents);
+
+  private:
+    EventModuloTunerMessenger* fMessenger = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/include/GeometrySweep.hh
+/// \brief Definition of the GdNCap::GeometrySweep class
+
+#ifndef GdNCapGeometrySweep_h
+#define GdNCapGeometrySweep_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Runs a grid of neutron energies, envelope thicknesses and envelope
+/// materials in one job (/GdNCap/sweep/run), instead of one job per point
+/// each paying the startup. Between the points only the geometry is
+/// rebuilt (/GdNCap/detector/..., which applies /run/reinitializeGeometry):
+/// the physics tables, the HP data and the worker threads are kept. The
+/// materials are defined when they are named, so /GdNCap/sweep/materials
+/// has to come before /run/initialize for their data to be loaded once;
+/// named later, they rebuild the physics tables at the next run.
+///
+/// The materials are the outer loop and the energies the inner one, so
+/// that the geometry changes as rarely as possible. Each point writes its
+/// outputs with the tag of the point (/GdNCap/output/tag), for example
+/// "E0.0253eV_T1mm_myGd157" with only the axes that are swept, and adds a
+/// line "<tag> <material> <thickness in mm> <energy in MeV> <events>
+/// <seconds>" to the index file Sweep.txt, "-" standing for an axis that
+/// is not swept. The settings changed by the sweep are restored after it,
+/// the gun energy of an MT master from GeometrySweepMessenger.
+///
+/// Created in main(), on the master only.
+
+namespace GdNCap
+{
+
+class DetectorConstruction;
+class GeometrySweepMessenger;
+
+class GeometrySweep
+{
+  public:
+    GeometrySweep(DetectorConstruction* detConstruction);
+    ~GeometrySweep();
+
+    /// Values in Geant4 units, printed in the tags with the given unit;
+    /// an empty list does not sweep the axis
+    void SetEnergies(const std::vector<G4double>& energies, const G4String& unit);
+    void SetThicknesses(const std::vector<G4double>& thicknesses, const G4String& unit);
+    /// Unknown materials are left out with a warning
+    void SetMaterials(const std::vector<G4String>& materials);
+    void SetIndexFile(const G4String& fileName) { fIndexFile = fileName; }
+
+    /// Run every point of the grid with nofEvents
+    void Run(G4int nofEvents);
+
+  private:
+    /// Values of a swept quantity and the unit of their tags
+    struct Axis
+    {
+      std::vector<G4double> fValues;
+      G4String fUnit;
+      G4double fUnitValue = 1.;
+    };
+
+    void SetAxis(Axis& axis, const std::vector<G4double>& values, const G4String& unit);
+    G4String FormatValue(const Axis& axis, G4double value) const;
+    G4bool Apply(const G4String& command) const;
+
+    DetectorConstruction* fDetConstruction = nullptr;
+    GeometrySweepMessenger* fMessenger = nullptr;
+    Axis fEnergies;
+    Axis fThicknesses;
+    std::vector<G4String> fMaterials;
+    G4String fIndexFile = "Sweep.txt";
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,82 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/include/GeometrySweepMessenger.hh
+/// \brief Definition of the GdNCap::GeometrySweepMessenger class
+
+#ifndef GdNCapGeometrySweepMessenger_h
+#define GdNCapGeometrySweepMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+
+/// Messenger of the GeometrySweep. It lives on the master only and its
+/// commands are not broadcast.
+///
+/// The master of a multi-threaded run has no gun, so /gun/energy has no
+/// current value there. Where no gun defines it, the messenger defines a
+/// /gun/energy command that keeps the value for the sweep to restore and
+/// is broadcast to the guns of the workers like the original one.
+
+namespace GdNCap
+{
+
+class GeometrySweep;
+
+class GeometrySweepMessenger : public G4UImessenger
+{
+  public:
+    GeometrySweepMessenger(GeometrySweep* sweep);
+    ~GeometrySweepMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+    G4String GetCurrentValue(G4UIcommand* command) override;
+
+  private:
+    GeometrySweep* fSweep = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithAString* fEnergiesCmd = nullptr;
+    G4UIcmdWithAString* fThicknessesCmd = nullptr;
+    G4UIcmdWithAString* fMaterialsCmd = nullptr;
+    G4UIcmdWithAString* fIndexFileCmd = nullptr;
+    G4UIcmdWithAnInteger* fRunCmd = nullptr;
+    G4UIdirectory* fGunDirectory = nullptr;
+    G4UIcmdWithADoubleAndUnit* fGunEnergyCmd = nullptr;
+    G4double fGunEnergy = 0.;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/H1Accumulable.hh
+/// \brief Definition of the GdNCap::H1Accumulable class
+
+#ifndef GdNCapH1Accumulable_h
+#define GdNCapH1Accumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// One-dimensional fixed-binning histogram usable as an accumulable.
+///
+/// The bins are either linear in x or linear in log(x). Bin 0 holds the
+/// underflow, NaN included, and bin nbins+1 the overflow. All threads must
+/// use the same binning; merging is then a plain bin-wise sum of contents
+/// and of the squared weights.
+
+namespace GdNCap
+{
+
+class H1Accumulable : public G4VAccumulable
+{
+  public:
+    enum class Binning { Linear, Log };
+
+    H1Accumulable(const G4String& name, G4int nbins, G4double xmin, G4double xmax,
+                  Binning binning = Binning::Linear);
+    ~H1Accumulable() override = default;
+
+    void Merge(const G4VAccumulable& other) final;
+    void Reset() final;
+
+    void SetBinning(G4int nbins, G4double xmin, G4double xmax, Binning binning);
+    void Fill(G4double x, G4double weight = 1.);
+
+    G4int GetNbins() const { return fNbins; }
+    G4double GetXmin() const { return fXmin; }
+    G4double GetXmax() const { return fXmax; }
+    Binning GetBinning() const { return fBinning; }
+    G4double GetBinLowEdge(G4int bin) const;
+    G4double GetBinContent(G4int bin) const { return fContent[bin]; }
+    G4double GetBinError(G4int bin) const { return std::sqrt(fSumW2[bin]); }
+    G4double GetEntries() const { return fEntries; }
+    std::size_t GetMemoryUsage() const
+      { return sizeof(H1Accumulable) + (fContent.capacity() + fSumW2.capacity()) * sizeof(G4double); }
+
+    /// Value below which the given fraction of the in-range content lies
+    G4double GetQuantile(G4double fraction) const;
+
+    void Write(const G4String& fileName, const G4String& title = "") const;
+
+  private:
+    G4int FindBin(G4double x) const;
+
+    G4int fNbins = 0;
+    G4double fXmin = 0.;
+    G4double fXmax = 0.;
+    Binning fBinning = Binning::Linear;
+    G4double fOrigin = 0.;     // xmin or log(xmin)
+    G4double fInvWidth = 0.;   // inverse bin width in x or log(x)
+    G4double fEntries = 0.;
+    std::vector<G4double> fContent;
+    std::vector<G4double> fSumW2;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/HPDataSubset.hh
+/// \brief Definition of the GdNCap::HPDataSubset class
+
+#ifndef GdNCapHPDataSubset_h
+#define GdNCapHPDataSubset_h 1
+
+#include "G4VStateDependent.hh"
+#include "globals.hh"
+
+#include <set>
+
+/// Reads the neutron HP data from a subset of G4NDL made by gdncap-hpprep
+/// (option -n <directory>): only the files of the elements in use, already
+/// decompressed, which saves the inflating and the reading of the whole
+/// G4NDL tree, often from a network file system, at every start.
+///
+/// The subset is selected by pointing G4NEUTRONHPDATA at it before the
+/// physics is constructed. As ParticleHP silently skips missing isotopes
+/// here (SetSkipMissingIsotopes), the elements of the material table are
+/// checked against the subset after /run/initialize, before the data are
+/// read at the first beamOn; a missing element is fatal and the command
+/// to remake the subset is printed.
+///
+/// Created in main(); the state manager owns and deletes it.
+
+namespace GdNCap
+{
+
+class HPDataSubset : public G4VStateDependent
+{
+  public:
+    explicit HPDataSubset(const G4String& directory);
+    ~HPDataSubset() override = default;
+
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+  private:
+    void CheckElements() const;
+
+    G4String fDirectory;
+    G4String fSource;
+    std::set<G4int> fElements;
+    G4bool fChecked = false;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
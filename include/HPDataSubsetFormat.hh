@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/HPDataSubsetFormat.hh
+/// \brief Definition of the manifest of a neutron HP data subset
+
+#ifndef GdNCapHPDataSubsetFormat_h
+#define GdNCapHPDataSubsetFormat_h 1
+
+/// A subset of the G4NDL neutron HP data, made by gdncap-hpprep and used
+/// by GdNeutronCapture through HPDataSubset, is a copy of the G4NDL
+/// directory tree with:
+///   - only the files of the selected elements among those named
+///     <Z>_<A>_<Element> or <Z>_nat_<Element>, all isotopes of an element
+///     being kept so that the isotope fallbacks of ParticleHP are unchanged;
+///   - all other files, e.g. of ThermalScattering, as they are;
+///   - the zlib-compressed <file>.z stored decompressed as <file>, which
+///     ParticleHP reads directly;
+///   - a manifest, kManifestName, of "key values..." lines:
+///       source <G4NDL directory>
+///       elements <Z>...
+///       files <number kept> <number in the source>
+///       bytes <size kept> <size in the source>
+///
+/// This header does not depend on Geant4.
+
+namespace GdNCap
+{
+namespace HPDataSubsetFormat
+{
+
+constexpr char kManifestName[] = "GdNCapHPData.txt";
+
+}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
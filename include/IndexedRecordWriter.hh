@@ -0,0 +1,95 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/IndexedRecordWriter.hh
+/// \brief Definition of the GdNCap::IndexedRecordWriter class
+
+#ifndef GdNCapIndexedRecordWriter_h
+#define GdNCapIndexedRecordWriter_h 1
+
+#include "VRecordWriter.hh"
+
+#include <cstdint>
+#include <fstream>
+
+/// Writer of capture records as one line per event, every event included,
+/// in increasing event ID order, plus a binary offset index.
+///
+/// CaptureRecords<suffix>.txt, after a '#' header line:
+///   eventID edep[MeV] totalEnergy[MeV] n energy_1[MeV] type_1 ... energy_n type_n
+/// where edep is "nan" when the secondaries were not transported. Biased
+/// runs write "energy_i type_i weight_i" for every secondary.
+///
+/// CaptureRecords<suffix>.idx, native byte order:
+///   char     magic[8]                "GDNCIDX1"
+///   uint64   nofRecords
+///   uint64   offset[nofRecords + 1]  byte offset of each record line in the
+///                                    .txt file, the last entry is its size
+/// For the output of a complete run record i is event i, so analysis code
+/// can seek straight to any event.
+
+namespace GdNCap
+{
+
+class IndexedRecordWriter : public VRecordWriter
+{
+  public:
+    static constexpr char kIndexMagic[9] = "GDNCIDX1";
+
+    IndexedRecordWriter() = default;
+    ~IndexedRecordWriter() override;
+
+    using VRecordWriter::Write;
+    void Open(const G4String& suffix = "") override;
+    void Write(const CaptureRecordView::Event& event) override;
+    void Close() override;
+    G4bool IsOpen() const override { return fRecordFile.is_open(); }
+    std::vector<G4String> GetFileNames(const G4String& suffix = "") const override;
+
+    G4bool CanFormatChunks() const override { return true; }
+    void FormatChunk(const std::vector<CaptureRecordView::Event>& events,
+                     Chunk& chunk) const override;
+    void WriteChunk(const Chunk& chunk) override;
+
+    static G4String GetRecordFileName(const G4String& suffix = "");
+    static G4String GetIndexFileName(const G4String& suffix = "");
+
+  private:
+    void FormatEvent(const CaptureRecordView::Event& event, Chunk& chunk) const;
+    void FlushIndex();
+
+    std::ofstream fRecordFile;
+    std::ofstream fIndexFile;
+    std::uint64_t fOffset = 0;
+    std::vector<std::uint64_t> fPendingOffsets;
+    Chunk fChunk;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
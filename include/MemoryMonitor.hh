@@ -0,0 +1,109 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/MemoryMonitor.hh
+/// \brief Definition of the GdNCap::MemoryMonitor class
+
+#ifndef GdNCapMemoryMonitor_h
+#define GdNCapMemoryMonitor_h 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+/// Memory accounting of the runs: the resident set size (RSS) of the
+/// process is sampled at the begin of run, at the end of each worker's
+/// run (the largest is kept), after the merge of the accumulables and
+/// after the output is written, and printed with the peak RSS by the
+/// master. RunAction adds the bytes held by its accumulables, per thread
+/// and merged.
+///
+/// With a memory budget (/GdNCap/memory/budget), the RSS is checked every
+/// kCheckInterval events. When its growth per event so far, at the
+/// current event rate, exceeds the budget before the end of the run, a
+/// warning tells when, so that a run keeping its records in memory can
+/// be stopped or changed (/GdNCap/output/mode stream) before the master
+/// runs out of memory at the end of run.
+///
+/// Created in main(), on the master only; the threads use Instance().
+
+namespace GdNCap
+{
+
+class MemoryMonitorMessenger;
+
+class MemoryMonitor
+{
+  public:
+    static constexpr G4long kCheckInterval = 1000;
+
+    MemoryMonitor();
+    ~MemoryMonitor();
+
+    /// The monitor of the job, nullptr if there is none
+    static MemoryMonitor* Instance() { return fgInstance; }
+
+    /// Budget of the RSS in MB, 0 for none
+    void SetBudget(G4double budget) { fBudget = budget; }
+
+    /// On the master, before the workers start their run
+    void BeginRun(G4int nofEvents);
+    /// Called at the end of every event, by any thread
+    void EndEvent();
+    /// Sample the RSS at the named point of the run, by any thread
+    void Sample(const G4String& point);
+    /// Print the samples of the run, on the master at the end of run
+    void Report() const;
+
+    /// Current and peak RSS of the process in MB, 0 if unknown
+    static G4double GetResidentSize();
+    static G4double GetPeakResidentSize();
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    void Check(G4long nofProcessed);
+
+    static MemoryMonitor* fgInstance;
+
+    MemoryMonitorMessenger* fMessenger = nullptr;
+    G4double fBudget = 0.;
+    G4int fNofEvents = 0;
+    Clock::time_point fStart;
+    G4double fStartSize = 0.;
+    std::atomic<G4long> fNofProcessed{0};
+    std::atomic<G4bool> fWarned{false};
+    std::vector<std::pair<G4String, G4double>> fSamples;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,65 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/MemoryMonitorMessenger.hh
+/// \brief Definition of the GdNCap::MemoryMonitorMessenger class
+
+#ifndef GdNCapMemoryMonitorMessenger_h
+#define GdNCapMemoryMonitorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithADouble;
+
+/// Messenger of the MemoryMonitor, on the master only.
+
+namespace GdNCap
+{
+
+class MemoryMonitor;
+
+class MemoryMonitorMessenger : public G4UImessenger
+{
+  public:
+    MemoryMonitorMessenger(MemoryMonitor* monitor);
+    ~MemoryMonitorMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    MemoryMonitor* fMonitor = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithADouble* fBudgetCmd = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/ParticleTypeTable.hh
+/// \brief Definition of the GdNCap::ParticleTypeTable class
+
+#ifndef GdNCapParticleTypeTable_h
+#define GdNCapParticleTypeTable_h 1
+
+#include "globals.hh"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// Process-wide table interning the names of recorded secondaries.
+///
+/// Capture records store a one-byte type ID per secondary instead of
+/// a G4String. IDs are assigned on first use and never change during
+/// the job, so records from different threads can be spliced together
+/// without remapping. Lookups of known names are lock-free; only the
+/// insertion of a new name takes a mutex.
+
+namespace GdNCap
+{
+
+class ParticleTypeTable
+{
+  public:
+    using TypeId = std::uint8_t;
+    static constexpr std::size_t kMaxTypes = 256;
+
+    static ParticleTypeTable* Instance();
+
+    TypeId Intern(const G4String& name);
+    const G4String& GetName(TypeId id) const { return fNames[id]; }
+    std::size_t GetNumberOfTypes() const
+      { return fNofTypes.load(std::memory_order_acquire); }
+
+  private:
+    ParticleTypeTable() = default;
+
+    std::array<G4String, kMaxTypes> fNames;
+    std::atomic<std::size_t> fNofTypes = 0;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
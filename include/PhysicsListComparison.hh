@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/PhysicsListComparison.hh
+/// \brief Definition of the GdNCap::PhysicsListComparison class
+
+#ifndef GdNCapPhysicsListComparison_h
+#define GdNCapPhysicsListComparison_h 1
+
+#include "ChildProcess.hh"
+#include "RunSummary.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Runs the same macro under several physics lists (option -c) and
+/// compares their cost and capture spectra.
+///
+/// As the physics list is fixed for the lifetime of a process, each list
+/// runs in a ChildProcess of this executable, with "-p <list> -r
+/// summary.txt", in its own directory compare_<list>/ where it also leaves
+/// its log and outputs. Reported per list:
+///   init      - /run/initialize plus the first run initialization, which
+///               builds the physics tables (see StartupMonitor)
+///   events/s  - all events of the macro over the master's event loops
+///   memory    - peak resident memory of the child process
+///   chi2/ndf  - of the gammaEnergy spectrum per event, against the first
+///               list, over the bins filled in either spectrum
+///   KS        - largest difference of the normalized cumulative spectra
+/// The histograms are those of the last run of the macro.
+
+namespace GdNCap
+{
+
+class PhysicsListComparison
+{
+  public:
+    /// The arguments are passed on to every child, before the macro
+    PhysicsListComparison(const G4String& program, const G4String& macro,
+                          const std::vector<G4String>& arguments);
+    ~PhysicsListComparison() = default;
+
+    /// Run all lists in turn, the first is the reference; false if any
+    /// child failed
+    G4bool Run(const std::vector<G4String>& physicsLists);
+
+  private:
+    struct Result
+    {
+      G4String fPhysicsList;
+      G4bool fSucceeded = false;
+      RunSummary::Totals fTotals;
+      G4double fPeakMemory = 0.;   // MB
+      std::vector<G4double> fSpectrum;
+      std::vector<G4double> fSpectrumError2;
+      G4double fChi2 = 0.;
+      G4int fNdf = 0;
+      G4double fKolmogorovDistance = 0.;
+    };
+
+    void ReadSpectrum(const G4String& fileName, Result& result) const;
+    void CompareSpectra(const Result& reference, Result& result) const;
+    void Print(const std::vector<Result>& results) const;
+
+    ChildProcess fChild;
+    G4String fMacro;
+    std::vector<G4String> fArguments;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
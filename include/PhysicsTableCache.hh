@@ -0,0 +1,89 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/PhysicsTableCache.hh
+/// \brief Definition of the GdNCap::PhysicsTableCache class
+
+#ifndef GdNCapPhysicsTableCache_h
+#define GdNCapPhysicsTableCache_h 1
+
+#include "G4VStateDependent.hh"
+#include "globals.hh"
+
+class G4VUserPhysicsList;
+
+/// On-disk cache of the physics tables (option -t <directory>).
+///
+/// At the first beamOn, before the tables are built, the job is
+/// fingerprinted by the Geant4 version, the physics list, the materials
+/// of the logical volumes with their composition, and the regions with
+/// their production cuts - what the material-cuts couples, and so the
+/// tables, depend on. The tables of a known fingerprint are retrieved
+/// from <directory>/<list>-<hash>/ instead of being built; otherwise they
+/// are stored there once built, through a temporary directory renamed in
+/// place, so that concurrent jobs never read a partial cache.
+///
+/// The neutron HP data are not part of the physics tables and are still
+/// read when they are built, see HPDataSubset; the saving is in the other
+/// processes. The startup times of both cases are those of StartupMonitor.
+///
+/// Created in main() after the physics list; the state manager owns and
+/// deletes it.
+
+namespace GdNCap
+{
+
+class PhysicsTableCache : public G4VStateDependent
+{
+  public:
+    PhysicsTableCache(const G4String& directory, const G4String& physicsListName,
+                      G4VUserPhysicsList* physicsList);
+    ~PhysicsTableCache() override = default;
+
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+  private:
+    G4String GetFingerprint() const;
+    void Prepare();
+    void Store();
+
+    G4String fDirectory;
+    G4String fPhysicsListName;
+    G4VUserPhysicsList* fPhysicsList = nullptr;
+
+    G4String fFingerprint;
+    G4String fTableDirectory;
+    G4bool fInitialized = false;
+    G4bool fPrepared = false;
+    G4bool fRetrieved = false;
+    G4bool fStored = false;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -32,8 +32,12 @@
 
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4ParticleGun.hh"
+#include "G4SystemOfUnits.hh"
 #include "globals.hh"
 
+#include "CascadeGenerator.hh"
+#include "PrimarySource.hh"
+
 class G4ParticleGun;
 class G4Event;
 class G4Box;
@@ -42,6 +46,16 @@ class G4Box;
 ///
 /// The default kinematic is a 6 MeV gamma, randomly distribued
 /// in front of the phantom across 80% of the (X,Y) phantom size.
+///
+/// The energy, position and direction are drawn by a PrimarySource
+/// (/GdNCap/source/...): its default keeps the gun energy and direction
+/// and the uniform position above. A sampled direction is rotated from
+/// the +z axis onto the gun direction.
+///
+/// When a cascade library is replayed (see RunAction), the gun is replaced
+/// by a CascadeGenerator emitting one capture cascade per event from a
+/// point uniformly distributed in the same (X,Y) area and the full depth
+/// of the envelope.
 
 namespace GdNCap
 {
@@ -49,6 +63,9 @@ namespace GdNCap
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
+    /// Energy of the gun until /gun/energy
+    static constexpr G4double kDefaultEnergy = 0.0253 * eV;
+
     PrimaryGeneratorAction();
     ~PrimaryGeneratorAction() override;
 
@@ -57,10 +74,22 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 
     // method to access particle gun
     const G4ParticleGun* GetParticleGun() const { return fParticleGun; }
+    const PrimarySource& GetSource() const { return fSource; }
 
   private:
     G4ParticleGun* fParticleGun = nullptr; // pointer a to G4 gun class
+    CascadeGenerator fCascadeGenerator;
+    PrimarySource fSource;
+    // Gun settings replaced by the source, restored when it no longer
+    // samples them, and the last values it set on the gun
+    G4double fGunEnergy = 0.;
+    G4ThreeVector fGunDirection;
+    G4double fSampledEnergy = 0.;
+    G4ThreeVector fSampledDirection;
+    G4bool fEnergySampled = false;
+    G4bool fDirectionSampled = false;
     G4Box* fEnvelopeBox = nullptr;
+    G4int fEnvelopeRunId = -1;
 };
 
 }
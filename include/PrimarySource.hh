@@ -0,0 +1,152 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/include/PrimarySource.hh
+/// \brief Definition of the GdNCap::PrimarySource class
+
+#ifndef GdNCapPrimarySource_h
+#define GdNCapPrimarySource_h 1
+
+#include "AliasTable.hh"
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Source of the primaries of PrimaryGeneratorAction, set with the
+/// /GdNCap/source/ commands (see PrimarySourceMessenger):
+///
+/// - energy: the gun energy (mono, the default), a Maxwellian of
+///   temperature kT, either the density sqrt(E) exp(-E/kT) or the flux
+///   E exp(-E/kT) of a thermal beam, or a histogram read from a file
+///   whose bin is drawn from an AliasTable;
+/// - position on the upstream face: uniform over a square (the default),
+///   a disc, a Gaussian spot of given FWHM or a point, all centred on the
+///   beam axis;
+/// - direction: the gun direction (beam, the default), uniform within a
+///   cone of given half-angle around it, or the cosine law of a surface
+///   crossed by an isotropic flux.
+///
+/// The samples are drawn in batches of events from one flatArray() of the
+/// thread's engine, each quantity in its own loop. With batches of more
+/// than one event (/GdNCap/source/batchSize), the primaries of an event
+/// no longer come from the random numbers of its own seeds, so a run is
+/// only reproducible with the same distribution of the events over the
+/// threads, and an event cannot be rerun from its saved engine status.
+/// The default draws each event's numbers at the event, which keeps the
+/// sequence of the uniform gun of the original example.
+///
+/// One instance per thread, owned by the PrimaryGeneratorAction.
+
+namespace GdNCap
+{
+
+class PrimarySourceMessenger;
+
+class PrimarySource
+{
+  public:
+    enum class Spectrum { Mono, Maxwellian, MaxwellianFlux, Table };
+    enum class Profile { Uniform, Disc, Gauss, Point };
+    enum class Angular { Beam, Cone, Cosine };
+
+    /// One primary; the position is given for a source of size 1, and the
+    /// direction around the +z axis
+    struct Sample
+    {
+      G4double fEnergy = 0.;
+      G4double fX = 0.;
+      G4double fY = 0.;
+      G4ThreeVector fDirection;
+    };
+
+    static constexpr G4int kDefaultBatchSize = 1;
+
+    PrimarySource();
+    ~PrimarySource();
+
+    void SetSpectrum(Spectrum spectrum);
+    void SetTemperature(G4double kT);
+    /// Histogram of lines "<low edge> <high edge> <content>", the edges in
+    /// the given unit and the content the probability of the bin, e.g. a
+    /// group flux; selects the table, or returns false keeping the
+    /// previous one if the file is unreadable
+    G4bool ReadTable(const G4String& fileName, G4double unit);
+    void SetProfile(Profile profile);
+    /// Side of the square, diameter of the disc or FWHM of the spot,
+    /// 0 for 80% of the envelope width
+    void SetSize(G4double size) { fSize = size; }
+    void SetAngular(Angular angular);
+    void SetDivergence(G4double halfAngle);
+    void SetBatchSize(G4int batchSize);
+
+    Spectrum GetSpectrum() const { return fSpectrum; }
+    Angular GetAngular() const { return fAngular; }
+    G4double GetSize() const { return fSize; }
+
+    /// The next primary, drawing a new batch when needed
+    const Sample& Next()
+    {
+      if (fNext == fSamples.size()) Fill();
+      return fSamples[fNext++];
+    }
+
+  private:
+    /// Drops the samples drawn with the previous settings
+    void Reset() { fSamples.clear(); fNext = 0; }
+    void Fill();
+    void FillEnergies(const G4double* randoms);
+    void FillPositions(const G4double* randoms);
+    void FillDirections(const G4double* randoms);
+
+    PrimarySourceMessenger* fMessenger = nullptr;
+
+    Spectrum fSpectrum = Spectrum::Mono;
+    G4double fTemperature = 0.;
+    // Bins of the table, the log of their edge ratio when sampled in ln E
+    AliasTable fTable;
+    std::vector<G4double> fLowEdges;
+    std::vector<G4double> fWidths;
+    std::vector<G4double> fLogRatios;
+
+    Profile fProfile = Profile::Uniform;
+    G4double fSize = 0.;
+    Angular fAngular = Angular::Beam;
+    G4double fCosDivergence = 1.;
+
+    G4int fBatchSize = kDefaultBatchSize;
+    std::vector<G4double> fRandoms;
+    std::vector<Sample> fSamples;
+    std::size_t fNext = 0;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/include/PrimarySourceMessenger.hh
+/// \brief Definition of the GdNCap::PrimarySourceMessenger class
+
+#ifndef GdNCapPrimarySourceMessenger_h
+#define GdNCapPrimarySourceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+
+/// Messenger of the PrimarySource of each worker; its commands are
+/// broadcast and take effect at the next event.
+
+namespace GdNCap
+{
+
+class PrimarySource;
+
+class PrimarySourceMessenger : public G4UImessenger
+{
+  public:
+    PrimarySourceMessenger(PrimarySource* source);
+    ~PrimarySourceMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    PrimarySource* fSource = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithAString* fSpectrumCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fTemperatureCmd = nullptr;
+    G4UIcommand* fTableCmd = nullptr;
+    G4UIcmdWithAString* fProfileCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fSizeCmd = nullptr;
+    G4UIcmdWithAString* fDirectionCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fDivergenceCmd = nullptr;
+    G4UIcmdWithAnInteger* fBatchSizeCmd = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
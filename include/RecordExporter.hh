@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/RecordExporter.hh
+/// \brief Definition of the GdNCap::RecordExporter class
+
+#ifndef GdNCapRecordExporter_h
+#define GdNCapRecordExporter_h 1
+
+#include "VRecordWriter.hh"
+
+/// Writes all events of a CaptureRecordView with a record writer and
+/// reports the write throughput.
+///
+/// With writers that format chunks (the text layouts), the merged event
+/// stream is cut into ranges of kEventsPerChunk events which are formatted
+/// concurrently on up to fNofThreads threads; the chunks are appended in
+/// event order by one writer task, overlapping with the formatting of the
+/// next ranges. Other writers are fed event by event.
+
+namespace GdNCap
+{
+
+class RecordExporter
+{
+  public:
+    static constexpr std::size_t kEventsPerChunk = 16384;
+
+    /// nofThreads <= 0 uses all cores
+    explicit RecordExporter(G4int nofThreads = 0);
+
+    /// Open the writer with the suffix, write the view and close it
+    void Export(const CaptureRecordView& view, VRecordWriter& writer,
+                const G4String& suffix = "");
+
+    G4int GetNumberOfThreads() const { return fNofThreads; }
+    std::uintmax_t GetNumberOfBytes() const { return fNofBytes; }
+    G4double GetRealElapsed() const { return fRealElapsed; }
+
+  private:
+    void WriteChunks(const CaptureRecordView& view, VRecordWriter& writer) const;
+
+    G4int fNofThreads = 1;
+    std::uintmax_t fNofBytes = 0;
+    G4double fRealElapsed = 0.;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,107 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/RecordQueue.hh
+/// \brief Definition of the GdNCap::RecordQueue class
+
+#ifndef GdNCapRecordQueue_h
+#define GdNCapRecordQueue_h 1
+
+#include "globals.hh"
+#include "ParticleTypeTable.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// Bounded lock-free queue of capture records, many producers and one
+/// consumer.
+///
+/// A ring of cells, each with a sequence number telling whether it is free
+/// for the producer claiming position pos (sequence == pos) or holds the
+/// record for the consumer (sequence == pos + 1). Producers claim positions
+/// with a compare-and-swap on the enqueue position and copy the record into
+/// the cell in place; the consumer swaps the cell's record with its own, so
+/// the vectors of both are recycled and a full ring does not allocate.
+/// Records of one producer are dequeued in the order they were pushed.
+
+namespace GdNCap
+{
+
+class RecordQueue
+{
+  public:
+    using TypeId = ParticleTypeTable::TypeId;
+
+    struct Record
+    {
+      G4int fProducer = 0;
+      G4int fEventId = 0;
+      G4double fEdep = 0.;
+      G4double fTotalEnergy = 0.;
+      std::vector<G4double> fEnergies;
+      std::vector<TypeId> fTypes;
+      std::vector<G4double> fWeights;
+    };
+
+    /// The capacity is rounded up to a power of two
+    explicit RecordQueue(std::size_t capacity);
+    ~RecordQueue() = default;
+
+    RecordQueue(const RecordQueue&) = delete;
+    RecordQueue& operator=(const RecordQueue&) = delete;
+
+    /// Thread-safe; false if the queue is full
+    G4bool TryPush(G4int producer, G4int eventId, G4double edep, G4double totalEnergy,
+                   const std::vector<G4double>& energies,
+                   const std::vector<TypeId>& types,
+                   const std::vector<G4double>& weights);
+
+    /// Consumer thread only; false if the queue is empty
+    G4bool TryPop(Record& record);
+
+    std::size_t GetCapacity() const { return fMask + 1; }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> fSequence;
+      Record fRecord;
+    };
+
+    std::unique_ptr<Cell[]> fCells;
+    std::size_t fMask = 0;
+    // Producers and consumer work on separate cache lines
+    alignas(64) std::atomic<std::size_t> fEnqueuePos{0};
+    alignas(64) std::size_t fDequeuePos = 0;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/include/RouletteOperation.hh
+/// \brief Definition of the GdNCap::RouletteOperation class
+
+#ifndef GdNCapRouletteOperation_h
+#define GdNCapRouletteOperation_h 1
+
+#include "G4VBiasingOperation.hh"
+#include "G4ParticleChange.hh"
+#include "globals.hh"
+
+/// Non-physics biasing operation playing Russian roulette at the end of
+/// the step: a track whose weight w is below the threshold is killed with
+/// the probability 1 - w/w_s, and otherwise survives with the weight w_s,
+/// which keeps the expected weight. The weight the track had before the
+/// roulette is kept for the scoring of the same step.
+
+namespace GdNCap
+{
+
+class RouletteOperation : public G4VBiasingOperation
+{
+  public:
+    RouletteOperation(const G4String& name);
+    ~RouletteOperation() override = default;
+
+    void SetWeights(G4double threshold, G4double survival)
+      { fThreshold = threshold; fSurvival = survival; }
+    /// Forget the step of the previous track
+    void Reset() { fTrack = nullptr; }
+    /// Weight of the track at the end of the step before the roulette,
+    /// the post-step weight if the roulette did not act on this step
+    G4double GetWeightBeforeRoulette(const G4Step* step) const;
+
+    const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+      const G4BiasingProcessInterface*, G4ForceCondition&) override { return nullptr; }
+    G4VParticleChange* ApplyFinalStateBiasing(
+      const G4BiasingProcessInterface*, const G4Track*, const G4Step*, G4bool&) override
+      { return nullptr; }
+    G4double DistanceToApplyOperation(const G4Track* track, G4double previousStepSize,
+                                      G4ForceCondition* condition) override;
+    G4VParticleChange* GenerateBiasingFinalState(const G4Track* track,
+                                                 const G4Step* step) override;
+
+  private:
+    G4ParticleChange fParticleChange;
+    G4double fThreshold = 0.;
+    G4double fSurvival = 0.;
+    // Last step seen by the operation
+    const G4Track* fTrack = nullptr;
+    G4int fStepNumber = 0;
+    G4double fWeightBefore = 0.;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -32,24 +32,63 @@
 
 #include "G4UserRunAction.hh"
 #include "G4Accumulable.hh"
+#include "G4Timer.hh"
 #include "globals.hh"
 
 #include "Accumulable.hh"
+#include "CaptureFilter.hh"
+#include "CascadeLibrary.hh"
+#include "AsyncRecordWriter.hh"
+#include "H1Accumulable.hh"
+#include "RunConditions.hh"
+#include "ShardManifest.hh"
+#include "SharedMemorySink.hh"
+#include "StepProfiler.hh"
+#include "VRecordWriter.hh"
+#include "WorkerTelemetry.hh"
+
+#include <array>
+#include <memory>
 
 class G4Run;
 
 /// Run action class
 ///
 /// In EndOfRunAction(), it calculates the dose in the selected volume
-/// from the energy deposit accumulated via stepping and event actions.
-/// The computed dose is then printed on the screen.
+/// from the energy deposit accumulated via stepping and event actions
+/// and prints it, unless the secondaries are not transported (see
+/// CaptureFilter), with the rate of events with capture products.
+///
+/// The capture records, keyed by event ID, are handled according to the
+/// output mode (see RunMessenger):
+/// - "memory": kept in memory and written by the master at end of run;
+/// - "stream": written block by block to per-thread shard files;
+/// - "async":  written during the run by an I/O thread of the master
+///             (see AsyncRecordWriter);
+/// - "analysis": filled into G4AnalysisManager ntuples;
+/// - "none":   only the capture histograms are written.
+/// The record file formats are described in CaptureRecordFormat.hh and
+/// the text layouts are formatted by RecordExporter. In any mode the
+/// events can also be published live (see SharedMemorySink).
+///
+/// The run action also merges the cascade library (see CascadeLibrary),
+/// prints the weighted yields and figures of merit of biased runs (see
+/// DetectorConstruction), the event timing of the workers (see
+/// WorkerTelemetry) and the memory use of the run (see MemoryMonitor).
 
 namespace GdNCap
 {
 
+class RunMessenger;
+
 class RunAction : public G4UserRunAction
 {
   public:
+    enum class OutputMode { Memory, Stream, Async, Analysis, None };
+    enum class OutputFormat { Record, Text, Binary };
+    enum HistoId { kGammaEnergyH, kCaptureEnergyH, kMultiplicityH, kEdepH,
+                   kCaptureDepthH, kEventTimeH, kEventCpuTimeH, kNofHistos };
+
     RunAction();
     ~RunAction();// override = default;
 
@@ -57,13 +96,126 @@ class RunAction : public G4UserRunAction
     void   EndOfRunAction(const G4Run*) override;
 
     void AddEdep (G4double edep);
-    void PushSecondariesList(std::vector<std::pair<G4double, G4String>> fSecL);
-    void PushSecondariesEnergy(G4double fSecE);
+    void AddSteps(G4long nofSteps) { fNofSteps += nofSteps; }
+    void CountCapture() { fNofCaptures += 1; }
+    /// Per-event weighted capture yield and transmission
+    void AddTallies(G4double captureYield, G4double transmission);
+    /// Wall and CPU times of an event and the part spent in the event actions
+    void AddEventTime(G4double wallTime, G4double cpuTime, G4double userActionTime);
+    void PushSecondaries(G4int eventId, G4double edep, G4double secE,
+                         const std::vector<G4double>& secEnergy,
+                         const std::vector<ParticleTypeTable::TypeId>& secType,
+                         const std::vector<G4double>& secWeight);
+
+    void FillHisto(HistoId id, G4double x, G4double weight = 1.)
+      { fHistos[id]->Fill(x, weight); }
+
+    OutputMode GetOutputMode() const { return fOutputMode; }
+    const G4String& GetOutputTag() const { return fOutputTag; }
+    const CaptureFilter* GetCaptureFilter() const { return fCaptureFilter; }
+    StepProfiler* GetStepProfiler() const { return fStepProfiler; }
+    /// This thread's cascade library while one is built, nullptr otherwise
+    CascadeLibrary* GetCascadeLibrary() const
+      { return fCascadeBuildFile.empty() ? nullptr : fCascadeLibrary; }
+    /// The library replayed in this run, nullptr if none
+    static const CascadeLibrary* GetReplayLibrary() { return fgReplayLibrary; }
+    G4int GetEventNtupleId() const { return fEventNtupleId; }
+    G4int GetSecondaryNtupleId() const { return fSecondaryNtupleId; }
+
+    void SetOutputMode(OutputMode mode) { fOutputMode = mode; }
+    void SetOutputFormat(OutputFormat format) { fOutputFormat = format; }
+    void SetCompressionLevel(G4int level) { fCompressionLevel = level; }
+    void SetWriterThreads(G4int nofThreads) { fWriterThreads = nofThreads; }
+    void SetQueueCapacity(G4int capacity) { fQueueCapacity = capacity; }
+    void SetSharedMemory(const G4String& name);
+    /// Tag appended as "_<tag>" to the names of the output files, "none" clears it
+    void SetOutputTag(const G4String& tag) { fOutputTag = (tag == "none") ? "" : tag; }
+    void SetNtupleFileType(const G4String& fileType) { fNtupleFileType = fileType; }
+    void SetNtupleMerging(G4bool merging) { fNtupleMerging = merging; }
+    void SetSharedMemorySlots(G4int nofSlots) { fSharedMemorySlots = nofSlots; }
+    void SetBlockSize(G4int blockSize);
+    void SetCascadeBuildFile(const G4String& fileName);
+    void SetCascadeMaxPerIsotope(G4long maxCascades) { fCascadeLibrary->SetMaxCascades(maxCascades); }
+    void SetCascadeReplayFile(const G4String& fileName);
+    void SetCascadeReplayIsotope(G4int Z, G4int A) { fReplayZ = Z; fReplayA = A; }
+    G4bool SetHistoBinning(const G4String& name, G4int nbins, G4double xmin,
+                           G4double xmax, H1Accumulable::Binning binning);
 
   private:
+    /// Estimate of a per-event tally
+    struct Tally
+    {
+      G4double fMean = 0.;
+      G4double fRelativeError = 0.;
+      G4double fFigureOfMerit = 0.;
+    };
+
+    std::unique_ptr<VRecordWriter> CreateRecordWriter() const;
+    G4String GetOutputSuffix() const { return fOutputTag.empty() ? "" : "_" + fOutputTag; }
+    void CloseShard();
+    Tally GetTally(G4double sum, G4double sum2, G4int nofEvents) const;
+    /// Print the tally with its gain over the unbiased one, if any, and
+    /// warn if they differ by more than kMaxDeviation standard deviations
+    void PrintTally(const G4String& name, const Tally& tally, const Tally* unbiased) const;
+    void PrintTelemetry(G4int runId, G4double mergeTime, G4double writeTime) const;
+    void PrintAccumulableMemory() const;
+
+    RunMessenger* fMessenger = nullptr;
+    CaptureFilter* fCaptureFilter = nullptr;
+    StepProfiler* fStepProfiler = nullptr;
+    G4Timer fTimer;
+    OutputMode fOutputMode = OutputMode::Memory;
+    OutputFormat fOutputFormat = OutputFormat::Record;
+    G4int fCompressionLevel = 0;
+    G4int fWriterThreads = 0;
+    G4int fQueueCapacity = AsyncRecordWriter::kDefaultQueueCapacity;
+    G4String fOutputTag;
+    std::unique_ptr<VRecordWriter> fShardWriter;
+    // Owned by the master, used by all threads in async mode
+    std::unique_ptr<AsyncRecordWriter> fAsyncWriter;
+    static AsyncRecordWriter* fgAsyncWriter;
+    // Owned by the master, published to by all threads when set
+    G4String fSharedMemoryName;
+    G4int fSharedMemorySlots = SharedMemorySink::kDefaultNofSlots;
+    std::unique_ptr<SharedMemorySink> fSharedMemorySink;
+    static SharedMemorySink* fgSharedMemorySink;
+    // Ntuples of the analysis mode, booked on every thread
+    G4String fNtupleFileType = "csv";
+    G4bool fNtupleMerging = true;
+    G4int fEventNtupleId = -1;
+    G4int fSecondaryNtupleId = -1;
+    G4int fProducerId = 0;
+    // Cascade library built on every thread, written by the master
+    G4String fCascadeBuildFile;
+    CascadeLibrary* fCascadeLibrary = nullptr;
+    // Owned by the master, replayed by all threads when set
+    G4String fReplayFile;
+    G4String fLoadedReplayFile;
+    G4int fReplayZ = 0;
+    G4int fReplayA = 0;
+    std::unique_ptr<CascadeLibrary> fReplayLibrary;
+    static const CascadeLibrary* fgReplayLibrary;
+    // Tallies of the last unbiased run, the reference of the biased ones
+    static constexpr G4double kMaxDeviation = 3.;
+    Tally fUnbiasedCapture;
+    Tally fUnbiasedTransmission;
+    // Time of all threads in Merge(), summed under a lock for the master
+    static G4double fgMergeTime;
+
+
     G4Accumulable<G4double> fEdep = 0.;
     G4Accumulable<G4double> fEdep2 = 0.;
+    G4Accumulable<G4long> fNofSteps = 0;
+    G4Accumulable<G4long> fNofCaptures = 0;
+    G4Accumulable<G4double> fCaptureYield = 0.;
+    G4Accumulable<G4double> fCaptureYield2 = 0.;
+    G4Accumulable<G4double> fTransmission = 0.;
+    G4Accumulable<G4double> fTransmission2 = 0.;
     Accumulable* fSecondaries = nullptr;
+    ShardManifest* fShardManifest = nullptr;
+    RunConditions* fRunConditions = nullptr;
+    WorkerTelemetry* fWorkerTelemetry = nullptr;
+    std::array<H1Accumulable*, kNofHistos> fHistos = {};
 };
 
 }
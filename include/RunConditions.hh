@@ -0,0 +1,68 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/RunConditions.hh
+/// \brief Definition of the GdNCap::RunConditions class
+
+#ifndef GdNCapRunConditions_h
+#define GdNCapRunConditions_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+/// Accumulable carrying the primary particle settings of the workers to
+/// the master, which has no primary generator action of its own in
+/// multi-threaded mode.
+
+namespace GdNCap
+{
+
+class RunConditions : public G4VAccumulable
+{
+  public:
+    RunConditions() = default;
+    ~RunConditions() override = default;
+
+    void Merge(const G4VAccumulable& other) final;
+    void Reset() final;
+
+    void SetPrimary(const G4String& particleName, G4double energy)
+      { fParticleName = particleName; fEnergy = energy; }
+
+    G4bool IsSet() const { return !fParticleName.empty(); }
+    const G4String& GetParticleName() const { return fParticleName; }
+    G4double GetEnergy() const { return fEnergy; }
+
+  private:
+    G4String fParticleName;
+    G4double fEnergy = 0.;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/RunMessenger.hh
+/// \brief Definition of the GdNCap::RunMessenger class
+
+#ifndef GdNCapRunMessenger_h
+#define GdNCapRunMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+
+/// Messenger for the output, histogram and cascade library settings of
+/// RunAction.
+///
+/// One instance lives with each thread's RunAction; the commands are
+/// broadcast so master and workers share the same settings.
+
+namespace GdNCap
+{
+
+class RunAction;
+
+class RunMessenger : public G4UImessenger
+{
+  public:
+    RunMessenger(RunAction* runAction);
+    ~RunMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+    G4String GetCurrentValue(G4UIcommand* command) override;
+
+  private:
+    RunAction* fRunAction = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIdirectory* fOutputDirectory = nullptr;
+    G4UIcmdWithAString* fOutputModeCmd = nullptr;
+    G4UIcmdWithAString* fOutputFormatCmd = nullptr;
+    G4UIcmdWithAString* fOutputTagCmd = nullptr;
+    G4UIcmdWithAnInteger* fCompressionCmd = nullptr;
+    G4UIcmdWithAnInteger* fBlockSizeCmd = nullptr;
+    G4UIcmdWithAnInteger* fWriterThreadsCmd = nullptr;
+    G4UIcmdWithAnInteger* fQueueSizeCmd = nullptr;
+    G4UIcmdWithAString* fSharedMemoryCmd = nullptr;
+    G4UIcmdWithAnInteger* fSharedMemorySlotsCmd = nullptr;
+    G4UIcmdWithAString* fNtupleFileTypeCmd = nullptr;
+    G4UIcmdWithABool* fNtupleMergingCmd = nullptr;
+    G4UIdirectory* fHistoDirectory = nullptr;
+    G4UIcommand* fHistoBinningCmd = nullptr;
+    G4UIdirectory* fCascadeDirectory = nullptr;
+    G4UIcmdWithAString* fCascadeBuildCmd = nullptr;
+    G4UIcmdWithAnInteger* fCascadeMaxPerIsotopeCmd = nullptr;
+    G4UIcmdWithAString* fCascadeReplayCmd = nullptr;
+    G4UIcommand* fCascadeReplayIsotopeCmd = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,104 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/RunSummary.hh
+/// \brief Definition of the GdNCap::RunSummary class
+
+#ifndef GdNCapRunSummary_h
+#define GdNCapRunSummary_h 1
+
+#include "globals.hh"
+
+#include <fstream>
+#include <map>
+#include <vector>
+
+/// Machine-readable summary of a job, written by the master when a file
+/// is given with option -r. One "key values..." line per entry, appended
+/// as the job goes on so that a crashed job still leaves its startup:
+///
+///   physicsList <name>
+///   initialization <seconds>          time spent in /run/initialize
+///   runInitialization <run> <seconds> up to the first event, including
+///                                     the physics tables of the first run
+///   run <run> <events> <seconds>      event loop of the master
+///   physicsTableCache retrieved|stored <directory>
+///   phase <name> <seconds>            startup profile, see StartupMonitor
+///   eventTime <run> <p50> <p99> <imbalance>
+///                                     event time quantiles in seconds and
+///                                     worker imbalance, see RunAction
+///   memory <point>|peak <MB>          RSS samples of a run, see MemoryMonitor
+///   sweepPoint <tag> <events> <seconds>
+///                                     point of a sweep, see GeometrySweep
+///
+/// Read() parses such a file back and GetTotals() sums it up, for the
+/// comparison of physics lists and the benchmark.
+
+namespace GdNCap
+{
+
+class RunSummary
+{
+  public:
+    /// Entries of a summary file by key, in file order
+    using Entries = std::multimap<G4String, std::vector<G4String>>;
+
+    /// Startup and event loops of a job
+    struct Totals
+    {
+      G4double fInitTime = 0.;       // initialization and first run initialization
+      G4long fNofEvents = 0;         // all runs
+      G4double fEventTime = 0.;
+      G4int fLastRunEvents = 0;      // last run
+      G4double fLastRunTime = 0.;
+    };
+
+    static RunSummary* Instance();
+
+    void Open(const G4String& fileName);
+    G4bool IsOpen() const { return fFile.is_open(); }
+
+    void AddEntry(const G4String& key, const G4String& value);
+    void AddInitialization(G4double seconds);
+    void AddRunInitialization(G4int runId, G4double seconds);
+    void AddRun(G4int runId, G4int nofEvents, G4double seconds);
+    void AddPhase(const G4String& name, G4double seconds);
+
+    static Entries Read(const G4String& fileName);
+    static Totals GetTotals(const Entries& entries);
+
+  private:
+    RunSummary() = default;
+    ~RunSummary() = default;
+
+    std::ofstream fFile;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
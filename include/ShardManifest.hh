@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/ShardManifest.hh
+/// \brief Definition of the GdNCap::ShardManifest class
+
+#ifndef GdNCapShardManifest_h
+#define GdNCapShardManifest_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Accumulable collecting the description of the output shards written
+/// by each thread in streaming mode. Only this small summary travels to
+/// the master, which writes it out as the run manifest.
+
+namespace GdNCap
+{
+
+class ShardManifest : public G4VAccumulable
+{
+  public:
+    struct Shard
+    {
+      G4int fThreadId = 0;
+      std::vector<G4String> fFiles;
+      std::size_t fNofEvents = 0;
+      std::size_t fNofSecondaries = 0;
+    };
+
+    ShardManifest() = default;
+    ~ShardManifest() override = default;
+
+    void Merge(const G4VAccumulable& other) final;
+    void Reset() final;
+
+    void AddShard(const Shard& shard) { fShards.push_back(shard); }
+    const std::vector<Shard>& GetShards() const { return fShards; }
+
+    void Write(const G4String& fileName) const;
+
+  private:
+    std::vector<Shard> fShards;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
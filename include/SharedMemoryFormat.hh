@@ -0,0 +1,129 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/SharedMemoryFormat.hh
+/// \brief Definition of the shared-memory capture record ring layout
+
+#ifndef GdNCapSharedMemoryFormat_h
+#define GdNCapSharedMemoryFormat_h 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// Layout of the POSIX shared-memory object through which
+/// SharedMemorySink publishes every completed event to consumer processes
+/// on the same machine (see reader/include/SharedMemoryReader.hh).
+/// Native byte order, energies in MeV.
+///
+///   RingHeader                      at offset 0
+///   Slot[fNofSlots]                 at offset fHeaderSize, fSlotSize bytes each
+///
+/// Each Slot is followed, within fSlotSize, by
+///   float64 energy[fMaxSecondaries]  float64 weight[fMaxSecondaries]
+///   uint8 type[fMaxSecondaries]
+/// The type IDs index RingHeader::fTypeNames; fNofTypes is published before
+/// any slot refers to a new type.
+///
+/// Protocol. The event published at position pos (pos = 0, 1, 2, ...) goes
+/// to slot pos % fNofSlots. Its writer sets the slot sequence to 2*pos + 1,
+/// fills the slot and sets the sequence to 2*pos + 2. A consumer that wants
+/// position pos
+///   - loads the sequence (acquire): below 2*pos + 2 the event is not yet
+///     complete, above it the slot has been reused and the consumer has
+///     fallen more than fNofSlots events behind (resume from
+///     fWritePos - fNofSlots);
+///   - reads the slot in place, then loads the sequence again: if it
+///     changed, the slot was overwritten meanwhile and the data is void.
+/// The writers never wait for consumers, so a slow or absent consumer
+/// cannot slow down the simulation; it loses events instead.
+///
+/// This header does not depend on Geant4.
+
+namespace GdNCap
+{
+namespace SharedMemoryFormat
+{
+
+constexpr char kMagic[9] = "GDNCSHM2";
+constexpr std::uint32_t kVersion = 2;
+constexpr std::size_t kMaxTypes = 256;
+constexpr std::size_t kTypeNameLength = 32;
+constexpr std::size_t kAlignment = 64;
+
+enum State : std::uint32_t { kRunning = 1, kFinished = 2 };
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "the ring needs address-free 64-bit atomics");
+
+struct alignas(kAlignment) RingHeader
+{
+  char fMagic[8];
+  std::uint32_t fVersion;
+  std::uint32_t fHeaderSize;
+  std::uint64_t fNofSlots;                 // a power of two
+  std::uint64_t fSlotSize;
+  std::uint32_t fMaxSecondaries;
+  std::uint32_t fProducerPid;
+  alignas(kAlignment) std::atomic<std::uint64_t> fWritePos;  // next position to claim
+  alignas(kAlignment) std::atomic<std::uint32_t> fState;
+  std::atomic<std::uint32_t> fRunId;       // increased at the start of each run
+  std::atomic<std::uint32_t> fNofTypes;
+  char fTypeNames[kMaxTypes][kTypeNameLength];
+};
+
+struct alignas(kAlignment) Slot
+{
+  std::atomic<std::uint64_t> fSequence;
+  std::int32_t fEventId;
+  std::uint32_t fRunId;
+  std::uint32_t fNofSecondaries;           // stored in energy[] and type[]
+  std::uint32_t fMultiplicity;             // of the event, may exceed fMaxSecondaries
+  double fEdep;                            // NaN if not scored
+  double fTotalEnergy;
+};
+
+constexpr std::size_t Align(std::size_t size)
+  { return (size + kAlignment - 1) / kAlignment * kAlignment; }
+
+constexpr std::size_t GetSlotSize(std::size_t maxSecondaries)
+  { return Align(sizeof(Slot) + maxSecondaries * (2 * sizeof(double) + 1)); }
+
+inline const double* GetEnergies(const Slot* slot)
+  { return reinterpret_cast<const double*>(slot + 1); }
+
+inline const double* GetWeights(const Slot* slot, std::size_t maxSecondaries)
+  { return GetEnergies(slot) + maxSecondaries; }
+
+inline const std::uint8_t* GetTypes(const Slot* slot, std::size_t maxSecondaries)
+  { return reinterpret_cast<const std::uint8_t*>(GetWeights(slot, maxSecondaries) + maxSecondaries); }
+
+}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
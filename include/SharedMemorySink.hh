@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/SharedMemorySink.hh
+/// \brief Definition of the GdNCap::SharedMemorySink class
+
+#ifndef GdNCapSharedMemorySink_h
+#define GdNCapSharedMemorySink_h 1
+
+#include "globals.hh"
+#include "ParticleTypeTable.hh"
+#include "SharedMemoryFormat.hh"
+
+#include <vector>
+
+/// Publishes every completed event into a POSIX shared-memory ring, with
+/// the layout and sequence protocol of SharedMemoryFormat.hh, so that a
+/// monitoring process on the same machine can follow the run live
+/// (see reader/gdncap-monitor.cc).
+///
+/// Publish() is thread-safe and never waits for consumers. Events with more
+/// secondaries than the slots hold are published truncated, with their
+/// full multiplicity. The shared-memory object is removed when the sink is
+/// destroyed; consumers that are attached keep their mapping and see the
+/// finished state.
+
+namespace GdNCap
+{
+
+class SharedMemorySink
+{
+  public:
+    static constexpr std::size_t kDefaultNofSlots = 4096;
+    static constexpr std::size_t kDefaultMaxSecondaries = 64;
+
+    SharedMemorySink(const G4String& name, std::size_t nofSlots = kDefaultNofSlots,
+                     std::size_t maxSecondaries = kDefaultMaxSecondaries);
+    ~SharedMemorySink();
+
+    SharedMemorySink(const SharedMemorySink&) = delete;
+    SharedMemorySink& operator=(const SharedMemorySink&) = delete;
+
+    G4bool IsOpen() const { return fHeader != nullptr; }
+    const G4String& GetName() const { return fName; }
+    std::size_t GetNumberOfSlots() const { return fNofSlots; }
+
+    void BeginRun();
+    void EndRun();
+
+    void Publish(G4int eventId, G4double edep, G4double totalEnergy,
+                 const std::vector<G4double>& energies,
+                 const std::vector<ParticleTypeTable::TypeId>& types,
+                 const std::vector<G4double>& weights);
+
+  private:
+    void PublishTypes();
+    SharedMemoryFormat::Slot* GetSlot(std::uint64_t pos) const;
+
+    G4String fName;
+    std::size_t fNofSlots = 0;
+    std::size_t fMaxSecondaries = 0;
+    std::size_t fSize = 0;
+    SharedMemoryFormat::RingHeader* fHeader = nullptr;
+    char* fSlots = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
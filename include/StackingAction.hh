@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/StackingAction.hh
+/// \brief Definition of the GdNCap::StackingAction class
+
+#ifndef GdNCapStackingAction_h
+#define GdNCapStackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+class G4ParticleDefinition;
+
+/// Stacking action of the capture-only transport modes.
+///
+/// The capture products are recorded by the stepping or tracking action
+/// before the secondaries reach the stack, so in the "killSecondaries"
+/// mode of CaptureFilter every secondary can be killed here, and in the
+/// "captureGammas" mode every secondary but the gammas created by the
+/// capture. Primaries and secondary neutrons, which include the clones of
+/// the biasing operations, are always tracked. In the "full" mode, the
+/// default, all tracks are urgent.
+
+namespace GdNCap
+{
+
+class CaptureFilter;
+
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    StackingAction(const CaptureFilter* captureFilter);
+    ~StackingAction() override = default;
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+
+  private:
+    const CaptureFilter* fCaptureFilter = nullptr;
+    const G4ParticleDefinition* fGamma = nullptr;
+    const G4ParticleDefinition* fNeutron = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,114 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/StartupMonitor.hh
+/// \brief Definition of the GdNCap::StartupMonitor class
+
+#ifndef GdNCapStartupMonitor_h
+#define GdNCapStartupMonitor_h 1
+
+#include "G4VStateDependent.hh"
+#include "G4Timer.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+/// Startup profile of the job, from its creation in main() to the end of
+/// the first event, by phase:
+///   rng, runManager, vis  - timed in main() with BeginPhase()/EndPhase()
+///   geometry              - DetectorConstruction::Construct(), AddPhase()
+///   physics               - rest of /run/initialize: particles, processes
+///   physicsTables         - first run initialization, which builds (or
+///                           retrieves, see PhysicsTableCache) the physics
+///                           tables and reads the neutron HP data
+///   firstEvent            - from there to the end of the first event of
+///                           any thread, including the start of the workers
+/// and the rest of the wall time, e.g. macro commands, as "other". The
+/// profile is printed and added to the RunSummary by Report(), at the end
+/// of the first run with events.
+///
+/// /run/initialize and the run initializations are also reported on
+/// their own, from the time spent in the Init state of the master:
+///   /run/initialize     : Init -> Idle
+///   run initialization  : at beamOn, Idle -> Init -> Idle -> GeomClosed
+/// As both end with Init -> Idle, a phase is only reported at the next
+/// change: a run initialization if it is GeomClosed, else /run/initialize.
+///
+/// Created in main(); the state manager owns and deletes it.
+
+namespace GdNCap
+{
+
+class StartupMonitor : public G4VStateDependent
+{
+  public:
+    StartupMonitor();
+    ~StartupMonitor() override;
+
+    /// The monitor of the job, nullptr if there is none
+    static StartupMonitor* Instance() { return fgInstance; }
+
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+    /// Phases of the master before the first event, timed by the caller
+    void BeginPhase(const G4String& name);
+    void EndPhase();
+    void AddPhase(const G4String& name, G4double seconds);
+
+    /// Called at the end of every event, by any thread; only the first
+    /// one counts
+    void EndEvent();
+
+    /// Print the profile once, on the master at the end of a run
+    void Report();
+
+  private:
+    void ReportInitialization();
+
+    static StartupMonitor* fgInstance;
+
+    G4Timer fTimer;
+    G4bool fPending = false;
+    G4double fPendingTime = 0.;
+    G4int fNofRunInitializations = 0;
+
+    G4Timer fTotalTimer;
+    G4Timer fPhaseTimer;
+    G4String fPhase;
+    std::vector<std::pair<G4String, G4double>> fPhases;
+    G4double fGeometryTime = 0.;
+    G4Timer fFirstEventTimer;
+    std::atomic<G4bool> fFirstEventDone{false};
+    G4bool fReported = false;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
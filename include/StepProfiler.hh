@@ -0,0 +1,143 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/StepProfiler.hh
+/// \brief Definition of the GdNCap::StepProfiler class
+
+#ifndef GdNCapStepProfiler_h
+#define GdNCapStepProfiler_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+/// Opt-in accumulable profile of the steps by (logical volume, particle,
+/// process defining the step): the number of steps, their track length
+/// and the time spent in the stepping action.
+///
+/// During the run each thread counts in a dense table indexed by IDs
+/// given to the volume, particle and process pointers in their order of
+/// appearance, so a step only costs a few array accesses and two clock
+/// readings. The pointers are resolved to names by Flush() at the end of
+/// the run, before the merge, as the process objects differ between the
+/// threads. The master prints the triples ranked by stepping action time,
+/// and writes the full table (see StepProfilerMessenger).
+
+namespace GdNCap
+{
+
+class StepProfilerMessenger;
+
+class StepProfiler : public G4VAccumulable
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Totals of one (volume, particle, process) triple
+    struct Entry
+    {
+      G4String fVolume;
+      G4String fParticle;
+      G4String fProcess;
+      G4long fNofSteps = 0;
+      G4double fTrackLength = 0.;
+      G4double fTime = 0.;           // s
+    };
+
+    StepProfiler();
+    ~StepProfiler() override;
+
+    void Merge(const G4VAccumulable& other) final;
+    void Reset() final;
+
+    void SetEnabled(G4bool enabled) { fEnabled = enabled; }
+    void SetNofRows(G4int nofRows) { fNofRows = nofRows; }
+    void SetFileName(const G4String& fileName) { fFileName = fileName; }
+    G4bool IsEnabled() const { return fEnabled; }
+
+    void AddStep(const G4LogicalVolume* volume, const G4ParticleDefinition* particle,
+                 const G4VProcess* process, G4double stepLength, Clock::duration time);
+
+    /// Resolve this thread's table to named entries, at the end of run
+    void Flush();
+    /// Named entries by decreasing time
+    std::vector<Entry> GetEntries() const;
+    /// Print the hot spots and write the full table, on the master
+    void Report() const;
+    /// Bytes held by the tables, approximately for the named entries
+    std::size_t GetMemoryUsage() const;
+
+  private:
+    /// Dense IDs of the pointers met by this thread
+    class PointerIds
+    {
+      public:
+        G4int Get(const void* pointer);
+        const std::vector<const void*>& GetPointers() const { return fPointers; }
+        void Clear();
+
+      private:
+        std::unordered_map<const void*, G4int> fIds;
+        std::vector<const void*> fPointers;
+        const void* fLast = nullptr;
+        G4int fLastId = -1;
+    };
+
+    struct Cell
+    {
+      G4long fNofSteps = 0;
+      G4double fTrackLength = 0.;
+      Clock::rep fTime = 0;
+    };
+
+    using Key = std::tuple<G4String, G4String, G4String>;
+
+    StepProfilerMessenger* fMessenger = nullptr;
+    G4bool fEnabled = false;
+    G4int fNofRows = 20;
+    G4String fFileName = "StepProfile.txt";
+    PointerIds fVolumeIds;
+    PointerIds fParticleIds;
+    PointerIds fProcessIds;
+    // Cells by volume, particle and process ID
+    std::vector<std::vector<std::vector<Cell>>> fCells;
+    std::map<Key, Entry> fEntries;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -33,28 +33,50 @@
 #include "G4UserSteppingAction.hh"
 #include "globals.hh"
 
+#include <vector>
+
 class G4LogicalVolume;
+class G4ParticleDefinition;
 
 /// Stepping action class
 ///
+/// Accumulates the energy deposit in the scoring volume and records the
+/// secondaries selected by the thread's CaptureFilter. While a cascade
+/// library is built, it also passes the gammas of each capture to it.
+/// Deposits and captures are weighted with the track weight.
+///
+/// When the StepProfiler is enabled, every step is counted in it with the
+/// time spent in this action.
 
 namespace GdNCap
 {
 
 class EventAction;
+class CaptureFilter;
+class DetectorConstruction;
+class StepProfiler;
 
 class SteppingAction : public G4UserSteppingAction
 {
   public:
-    SteppingAction(EventAction* eventAction);
+    SteppingAction(EventAction* eventAction, const CaptureFilter* captureFilter,
+                   StepProfiler* stepProfiler);
     ~SteppingAction() override = default;
 
     // method from the base class
     void UserSteppingAction(const G4Step*) override;
 
   private:
+    /// Returns the logical volume of the step
+    G4LogicalVolume* ScoreStep(const G4Step* step);
+    void RecordByName(const G4Step* step);
+
     EventAction* fEventAction = nullptr;
-    G4LogicalVolume* fScoringVolume = nullptr;
+    const CaptureFilter* fCaptureFilter = nullptr;
+    StepProfiler* fStepProfiler = nullptr;
+    const DetectorConstruction* fDetConstruction = nullptr;
+    const G4ParticleDefinition* fGamma = nullptr;
+    std::vector<G4double> fCascade;
 };
 
 }
@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/TextFormat.hh
+/// \brief Number formatting helpers of the text record writers
+
+#ifndef GdNCapTextFormat_h
+#define GdNCapTextFormat_h 1
+
+#include "globals.hh"
+
+#include <charconv>
+#include <string>
+
+/// Locale-independent number formatting into a user-space buffer.
+/// Floating-point values use the same representation as the default
+/// formatting of an ostream ("%g", 6 significant digits), so files stay
+/// identical to those written with operator<<.
+
+namespace GdNCap
+{
+namespace TextFormat
+{
+
+inline void Append(std::string& buffer, G4double value)
+{
+  char digits[32];
+  auto result = std::to_chars(digits, digits + sizeof(digits), value,
+                              std::chars_format::general, 6);
+  buffer.append(digits, result.ptr);
+}
+
+template <typename T>
+inline void AppendInteger(std::string& buffer, T value)
+{
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  buffer.append(digits, result.ptr);
+}
+
+}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
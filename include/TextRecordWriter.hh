@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/TextRecordWriter.hh
+/// \brief Definition of the GdNCap::TextRecordWriter class
+
+#ifndef GdNCapTextRecordWriter_h
+#define GdNCapTextRecordWriter_h 1
+
+#include "VRecordWriter.hh"
+
+#include <fstream>
+
+/// Writer of capture records in the legacy plain text layout:
+///   SecondaryTotalEnergy<suffix>.txt : summed energy of events with E > 0
+///   SecondaryEnergy<suffix>.txt      : one line of energies per non-empty event
+///   SecondaryName<suffix>.txt        : the matching particle names
+///   SecondaryWeight<suffix>.txt      : the matching weights, biased runs only
+/// As events are dropped differently in the three files, they cannot be
+/// joined row by row; see IndexedRecordWriter for a per-event layout.
+///
+/// Lines are formatted into large user-space buffers which are written
+/// without flushing the streams line by line.
+
+namespace GdNCap
+{
+
+class TextRecordWriter : public VRecordWriter
+{
+  public:
+    TextRecordWriter() = default;
+    ~TextRecordWriter() override;
+
+    using VRecordWriter::Write;
+    void Open(const G4String& suffix = "") override;
+    void Write(const CaptureRecordView::Event& event) override;
+    void Close() override;
+    G4bool IsOpen() const override { return fEnergyFile.is_open(); }
+    std::vector<G4String> GetFileNames(const G4String& suffix = "") const override;
+
+    G4bool CanFormatChunks() const override { return true; }
+    void FormatChunk(const std::vector<CaptureRecordView::Event>& events,
+                     Chunk& chunk) const override;
+    void WriteChunk(const Chunk& chunk) override;
+
+    static G4String GetTotalEnergyFileName(const G4String& suffix = "");
+    static G4String GetEnergyFileName(const G4String& suffix = "");
+    static G4String GetNameFileName(const G4String& suffix = "");
+    static G4String GetWeightFileName(const G4String& suffix = "");
+
+  private:
+    enum { kTotalEnergyBuffer, kEnergyBuffer, kNameBuffer, kWeightBuffer, kNofBuffers };
+
+    void FormatEvent(const CaptureRecordView::Event& event, Chunk& chunk) const;
+
+    std::ofstream fTotalEnergyFile;
+    std::ofstream fEnergyFile;
+    std::ofstream fNameFile;
+    std::ofstream fWeightFile;
+    Chunk fChunk;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/TrackingAction.hh
+/// \brief Definition of the GdNCap::TrackingAction class
+
+#ifndef GdNCapTrackingAction_h
+#define GdNCapTrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4ParticleDefinition;
+
+/// Tracking action of the "sd" scoring mode.
+///
+/// At the end of each track that was ended by a capture process in the
+/// scoring volume, it records the capture products among the track's
+/// secondaries, as selected by the thread's CaptureFilter. This replaces
+/// the per-step checks of SteppingAction with one check per track. While
+/// a cascade library is built, it also passes the capture gammas to it.
+
+namespace GdNCap
+{
+
+class EventAction;
+class CaptureFilter;
+class DetectorConstruction;
+
+class TrackingAction : public G4UserTrackingAction
+{
+  public:
+    TrackingAction(EventAction* eventAction, const CaptureFilter* captureFilter);
+    ~TrackingAction() override = default;
+
+    void PostUserTrackingAction(const G4Track* track) override;
+
+  private:
+    EventAction* fEventAction = nullptr;
+    const CaptureFilter* fCaptureFilter = nullptr;
+    const DetectorConstruction* fDetConstruction = nullptr;
+    const G4ParticleDefinition* fGamma = nullptr;
+    std::vector<G4double> fCascade;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/VRecordWriter.hh
+/// \brief Definition of the GdNCap::VRecordWriter class
+
+#ifndef GdNCapVRecordWriter_h
+#define GdNCapVRecordWriter_h 1
+
+#include "globals.hh"
+#include "CaptureRecordView.hh"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Abstract writer of capture records. Concrete writers define the file
+/// layout; the suffix passed to Open() distinguishes per-thread shards.
+///
+/// Text writers can also format ranges of events into Chunks independently
+/// of each other (FormatChunk() is const and thread-safe) and append them
+/// in order with WriteChunk(), which RecordExporter uses to format on
+/// several threads.
+
+namespace GdNCap
+{
+
+class VRecordWriter
+{
+  public:
+    /// Formatted output of a range of events
+    struct Chunk
+    {
+      std::vector<std::string> fBuffers;       // one per output file
+      std::vector<std::uint32_t> fRecordEnds;  // per event, end of its record in fBuffers[0]
+      std::size_t fNofEvents = 0;
+      std::size_t fNofSecondaries = 0;
+
+      void Clear();
+      std::size_t GetSize() const;
+    };
+
+    VRecordWriter() = default;
+    virtual ~VRecordWriter() = default;
+
+    virtual void Open(const G4String& suffix = "") = 0;
+    virtual void Write(const CaptureRecordView::Event& event) = 0;
+    virtual void Close() = 0;
+    virtual G4bool IsOpen() const = 0;
+
+    /// Names of the files written for the given suffix
+    virtual std::vector<G4String> GetFileNames(const G4String& suffix = "") const = 0;
+
+    /// Run conditions stored by the formats that have a header
+    void SetPrimary(const G4String& particleName, G4double energy)
+      { fPrimaryName = particleName; fPrimaryEnergy = energy; }
+    /// The text formats write the secondaries' weights only for biased
+    /// runs; has to be set before Open()
+    void SetWeighted(G4bool weighted) { fWeighted = weighted; }
+    G4bool IsWeighted() const { return fWeighted; }
+
+    void Write(const CaptureRecordBlock& block);
+    void Write(const CaptureRecordView& view);
+
+    virtual G4bool CanFormatChunks() const { return false; }
+    virtual void FormatChunk(const std::vector<CaptureRecordView::Event>& events,
+                             Chunk& chunk) const;
+    virtual void WriteChunk(const Chunk& chunk);
+
+    std::size_t GetNumberOfEvents() const { return fNofEvents; }
+    std::size_t GetNumberOfSecondaries() const { return fNofSecondaries; }
+
+  protected:
+    G4String fPrimaryName;
+    G4double fPrimaryEnergy = 0.;
+    G4bool fWeighted = false;
+    std::size_t fNofEvents = 0;
+    std::size_t fNofSecondaries = 0;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
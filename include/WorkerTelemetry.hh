@@ -0,0 +1,92 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/include/WorkerTelemetry.hh
+/// \brief Definition of the GdNCap::WorkerTelemetry class
+
+#ifndef GdNCapWorkerTelemetry_h
+#define GdNCapWorkerTelemetry_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Accumulable of the event loop load of each thread processing events.
+///
+/// Every such thread adds one entry at the begin of run (Begin()) and
+/// counts its events in it, with their summed wall and CPU times, the
+/// part spent in our event actions, and the time it took to write its
+/// own output at the end of run. Merging appends the entries, so the
+/// master gets one per worker and can tell a straggler thread, with much
+/// more busy time than the others, from long-tail events, which show in
+/// the event time histograms of RunAction.
+
+namespace GdNCap
+{
+
+class WorkerTelemetry : public G4VAccumulable
+{
+  public:
+    struct Worker
+    {
+      G4int fThreadId = 0;
+      G4long fNofEvents = 0;
+      G4double fWallTime = 0.;         // s, summed over the events
+      G4double fCpuTime = 0.;          // s, of this thread
+      G4double fUserActionTime = 0.;   // s, in the event actions
+      G4double fWriteTime = 0.;        // s, output of this thread at end of run
+    };
+
+    WorkerTelemetry() = default;
+    ~WorkerTelemetry() override = default;
+
+    void Merge(const G4VAccumulable& other) final;
+    void Reset() final;
+
+    /// Open the entry of a thread processing events
+    void Begin(G4int threadId);
+    void AddEvent(G4double wallTime, G4double cpuTime, G4double userActionTime);
+    void AddWriteTime(G4double writeTime);
+
+    const std::vector<Worker>& GetWorkers() const { return fWorkers; }
+    /// Largest over mean busy (wall) time of the workers, 1 if balanced
+    G4double GetImbalance() const;
+    std::size_t GetMemoryUsage() const
+      { return sizeof(WorkerTelemetry) + fWorkers.capacity() * sizeof(Worker); }
+
+    /// CPU time used by the calling thread, in s
+    static G4double GetThreadCpuTime();
+
+  private:
+    std::vector<Worker> fWorkers;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,143 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/reader/gdncap-convert.cc
+/// \brief Converter of binary capture record files to the text layouts
+///
+/// Usage: gdncap-convert [-f text|record] [-s suffix] [-w] CaptureRecords.gdnc
+///
+///   text   : SecondaryTotalEnergy<suffix>.txt, SecondaryEnergy<suffix>.txt
+///            and SecondaryName<suffix>.txt as written by TextRecordWriter
+///   record : CaptureRecords<suffix>.txt as written by IndexedRecordWriter
+///            (without the offset index)
+///   -w     : also the secondaries' weights, as written for biased runs
+
+#include "CaptureRecordReader.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+  void PrintUsage()
+  {
+    std::cerr << "Usage: gdncap-convert [-f text|record] [-s suffix] [-w] file.gdnc" << std::endl;
+  }
+
+  void ConvertToText(GdNCap::CaptureRecordReader& reader, const std::string& suffix,
+                     bool weighted)
+  {
+    std::ofstream totalEnergyFile("SecondaryTotalEnergy" + suffix + ".txt");
+    std::ofstream energyFile("SecondaryEnergy" + suffix + ".txt");
+    std::ofstream nameFile("SecondaryName" + suffix + ".txt");
+    std::ofstream weightFile;
+    if (weighted) weightFile.open("SecondaryWeight" + suffix + ".txt");
+
+    GdNCap::CaptureRecordColumns block;
+    while (reader.NextBlock(block)) {
+      for (std::size_t i = 0; i < block.GetNumberOfEvents(); ++i) {
+        if (block.totalEnergy[i] > 0) totalEnergyFile << block.totalEnergy[i] << "\n";
+        if (block.multiplicity[i] == 0) continue;
+        for (auto j = block.offset[i]; j < block.offset[i + 1]; ++j) {
+          energyFile << block.energy[j] << " ";
+          nameFile << reader.GetTypeName(block.type[j]) << " ";
+          if (weighted) weightFile << block.weight[j] << " ";
+        }
+        energyFile << "\n";
+        nameFile << "\n";
+        if (weighted) weightFile << "\n";
+      }
+    }
+  }
+
+  void ConvertToRecord(GdNCap::CaptureRecordReader& reader, const std::string& suffix,
+                       bool weighted)
+  {
+    std::FILE* file = std::fopen(("CaptureRecords" + suffix + ".txt").c_str(), "w");
+    if (!file) throw std::runtime_error("Cannot create CaptureRecords" + suffix + ".txt");
+    std::fputs(weighted ? "# eventID edep[MeV] totalEnergy[MeV] n {energy[MeV] type weight}\n"
+                        : "# eventID edep[MeV] totalEnergy[MeV] n {energy[MeV] type}\n", file);
+
+    GdNCap::CaptureRecordColumns block;
+    while (reader.NextBlock(block)) {
+      for (std::size_t i = 0; i < block.GetNumberOfEvents(); ++i) {
+        std::fprintf(file, "%d %g %g %u", block.eventId[i], block.edep[i],
+                     block.totalEnergy[i], block.multiplicity[i]);
+        for (auto j = block.offset[i]; j < block.offset[i + 1]; ++j) {
+          std::fprintf(file, " %g %s", block.energy[j],
+                       reader.GetTypeName(block.type[j]).c_str());
+          if (weighted) std::fprintf(file, " %g", block.weight[j]);
+        }
+        std::fputc('\n', file);
+      }
+    }
+    std::fclose(file);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  std::string format = "text";
+  std::string suffix;
+  std::string fileName;
+  bool weighted = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-f") == 0 && i + 1 < argc) format = argv[++i];
+    else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) suffix = argv[++i];
+    else if (std::strcmp(argv[i], "-w") == 0) weighted = true;
+    else if (fileName.empty()) fileName = argv[i];
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+  if (fileName.empty() || (format != "text" && format != "record")) {
+    PrintUsage();
+    return 1;
+  }
+
+  try {
+    GdNCap::CaptureRecordReader reader(fileName);
+    std::cout << fileName << ": " << reader.GetNumberOfEvents() << " events of "
+              << reader.GetPrimaryName() << " at " << reader.GetPrimaryEnergy() << " MeV, "
+              << reader.GetNumberOfSecondaries() << " secondaries in "
+              << reader.GetNumberOfBlocks() << " blocks" << std::endl;
+    if (format == "text") ConvertToText(reader, suffix, weighted);
+    else ConvertToRecord(reader, suffix, weighted);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "gdncap-convert: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,220 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/reader/gdncap-hpprep.cc
+/// \brief Preprocessor of the G4NDL neutron HP data for GdNeutronCapture
+///
+/// Usage: gdncap-hpprep -z Z[,Z...] source target
+///
+/// Copies the G4NDL tree source (e.g. $G4NEUTRONHPDATA) to target, keeping
+/// only the data of the elements of atomic numbers Z, and decompressing
+/// the .z files, see HPDataSubsetFormat.hh. GdNeutronCapture -n target then
+/// reads the subset; it lists the elements it needs if some are missing.
+/// Without zlib the .z files are copied as they are.
+
+#include "HPDataSubsetFormat.hh"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef GDNCAP_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  void PrintUsage()
+  {
+    std::cerr << "Usage: gdncap-hpprep -z Z[,Z...] source target" << std::endl;
+  }
+
+  // Atomic number of a data file named <Z>_<A or nat>_<Element>, -1 for
+  // the files of no element
+  int GetZ(const std::string& fileName)
+  {
+    std::size_t digits = 0;
+    while (digits < fileName.size() && std::isdigit(static_cast<unsigned char>(fileName[digits]))) {
+      ++digits;
+    }
+    if (digits == 0 || digits == fileName.size() || fileName[digits] != '_') return -1;
+    return std::atoi(fileName.substr(0, digits).c_str());
+  }
+
+#ifdef GDNCAP_USE_ZLIB
+  bool Decompress(const fs::path& source, const fs::path& target)
+  {
+    std::ifstream in(source, std::ios::binary);
+    std::ofstream out(target, std::ios::binary);
+    if (!in || !out) return false;
+
+    z_stream stream = {};
+    if (inflateInit(&stream) != Z_OK) return false;
+    std::vector<char> input(1 << 16), output(1 << 18);
+    int status = Z_OK;
+    while (status != Z_STREAM_END && in) {
+      in.read(input.data(), input.size());
+      stream.next_in = reinterpret_cast<Bytef*>(input.data());
+      stream.avail_in = static_cast<uInt>(in.gcount());
+      if (stream.avail_in == 0) break;
+      do {
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+        status = inflate(&stream, Z_NO_FLUSH);
+        if (status != Z_OK && status != Z_STREAM_END) {
+          inflateEnd(&stream);
+          return false;
+        }
+        out.write(output.data(), output.size() - stream.avail_out);
+      } while (stream.avail_out == 0 && status != Z_STREAM_END);
+    }
+    inflateEnd(&stream);
+    return status == Z_STREAM_END && out.good();
+  }
+#endif
+
+  struct Counts
+  {
+    std::uint64_t fNofFiles = 0;
+    std::uint64_t fSize = 0;
+  };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  std::set<int> elements;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-z") == 0 && i + 1 < argc) {
+      std::istringstream list(argv[++i]);
+      std::string z;
+      while (std::getline(list, z, ',')) {
+        if (!z.empty()) elements.insert(std::atoi(z.c_str()));
+      }
+    }
+    else paths.push_back(argv[i]);
+  }
+  if (elements.empty() || paths.size() != 2) {
+    PrintUsage();
+    return 1;
+  }
+
+  std::error_code error;
+  const fs::path source = fs::canonical(paths[0], error);
+  if (error || !fs::is_directory(source)) {
+    std::cerr << "gdncap-hpprep: " << paths[0] << " is not a directory" << std::endl;
+    return 1;
+  }
+  const fs::path target = paths[1];
+  if (fs::exists(target)) {
+    std::cerr << "gdncap-hpprep: " << target << " exists already" << std::endl;
+    return 1;
+  }
+
+  // Made aside and renamed when complete, a job never sees a partial subset
+  fs::path temporary = target;
+  temporary += ".tmp";
+  fs::remove_all(temporary, error);
+
+  Counts kept, total;
+  std::uint64_t nofDecompressed = 0;
+  for (auto it = fs::recursive_directory_iterator(source, error);
+       !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+    const fs::path relative = fs::relative(it->path(), source);
+    if (it->is_directory()) {
+      fs::create_directories(temporary / relative);
+      continue;
+    }
+    if (!it->is_regular_file()) continue;
+
+    const auto size = it->file_size();
+    ++total.fNofFiles;
+    total.fSize += size;
+    std::string fileName = relative.filename().string();
+    const int z = GetZ(fileName);
+    if (z >= 0 && elements.count(z) == 0) continue;
+
+    fs::path output = temporary / relative;
+    bool copied = false;
+#ifdef GDNCAP_USE_ZLIB
+    if (output.extension() == ".z") {
+      output.replace_extension();
+      copied = Decompress(it->path(), output);
+      if (copied) ++nofDecompressed;
+    }
+    else
+#endif
+    {
+      copied = fs::copy_file(it->path(), output, error);
+    }
+    if (!copied) {
+      std::cerr << "gdncap-hpprep: cannot write " << output << std::endl;
+      fs::remove_all(temporary, error);
+      return 1;
+    }
+    ++kept.fNofFiles;
+    kept.fSize += fs::file_size(output);
+  }
+  if (error) {
+    std::cerr << "gdncap-hpprep: cannot read " << source << ": " << error.message() << std::endl;
+    fs::remove_all(temporary, error);
+    return 1;
+  }
+
+  {
+    std::ofstream manifest(temporary / GdNCap::HPDataSubsetFormat::kManifestName);
+    manifest << "source " << source.string() << "\nelements";
+    for (int z : elements) manifest << ' ' << z;
+    manifest << "\nfiles " << kept.fNofFiles << ' ' << total.fNofFiles
+             << "\nbytes " << kept.fSize << ' ' << total.fSize << '\n';
+  }
+  fs::rename(temporary, target, error);
+  if (error) {
+    std::cerr << "gdncap-hpprep: cannot rename to " << target << ": " << error.message() << std::endl;
+    fs::remove_all(temporary, error);
+    return 1;
+  }
+
+  std::cout << "gdncap-hpprep: " << kept.fNofFiles << " of " << total.fNofFiles
+            << " files, " << kept.fSize / 1048576. << " of " << total.fSize / 1048576.
+            << " MB, " << nofDecompressed << " decompressed, in " << target.string()
+            << std::endl;
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,168 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/reader/gdncap-monitor.cc
+/// \brief Reference consumer of the shared-memory capture record ring
+///
+/// Usage: gdncap-monitor [-i seconds] [-a] name
+///
+/// Attaches to the ring that GdNeutronCapture publishes to after
+/// /GdNCap/output/sharedMemory name (waiting for it to appear), and prints
+/// running statistics of the captures every interval until the producer
+/// finishes. With -a, the events already in the ring are included.
+
+#include "SharedMemoryReader.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+  void PrintUsage()
+  {
+    std::cerr << "Usage: gdncap-monitor [-i seconds] [-a] name" << std::endl;
+  }
+
+  struct Statistics
+  {
+    std::uint64_t fNofEvents = 0;
+    std::uint64_t fNofCaptures = 0;
+    double fSumEdep = 0.;
+    double fSumTotalEnergy = 0.;
+    std::uint64_t fSumMultiplicity = 0;
+    std::map<std::uint8_t, std::uint64_t> fNofSecondaries;
+  };
+
+  void Print(const GdNCap::SharedMemoryReader& reader, const Statistics& statistics,
+             std::uint64_t nofNewEvents, double seconds)
+  {
+    std::cout << "run " << reader.GetRunId()
+              << "  events " << statistics.fNofEvents
+              << "  rate " << nofNewEvents / seconds << "/s"
+              << "  lost " << reader.GetNumberOfLost();
+    if (statistics.fNofEvents > 0) {
+      std::cout << "  <edep> " << statistics.fSumEdep / statistics.fNofEvents << " MeV";
+    }
+    if (statistics.fNofCaptures > 0) {
+      std::cout << "  <E_capture> " << statistics.fSumTotalEnergy / statistics.fNofCaptures
+                << " MeV  <multiplicity> "
+                << double(statistics.fSumMultiplicity) / statistics.fNofCaptures;
+    }
+    for (const auto& [type, count] : statistics.fNofSecondaries) {
+      std::cout << "  " << reader.GetTypeName(type) << " " << count;
+    }
+    std::cout << std::endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  double interval = 1.;
+  bool fromStart = false;
+  std::string name;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-i") == 0 && i + 1 < argc) interval = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "-a") == 0) fromStart = true;
+    else if (name.empty()) name = argv[i];
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+  if (name.empty() || interval <= 0.) {
+    PrintUsage();
+    return 1;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  std::unique_ptr<GdNCap::SharedMemoryReader> reader;
+  while (!reader) {
+    try {
+      reader = std::make_unique<GdNCap::SharedMemoryReader>(name, fromStart);
+    }
+    catch (const std::runtime_error&) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+  }
+  std::cout << "gdncap-monitor: attached to " << name << " of process "
+            << reader->GetProducerPid() << ", " << reader->GetNumberOfSlots()
+            << " slots" << std::endl;
+
+  Statistics statistics;
+  std::uint64_t nofPrinted = 0;
+  auto lastPrint = Clock::now();
+  GdNCap::SharedMemoryReader::Event event;
+  for (;;) {
+    auto status = reader->Next(event);
+    if (status == GdNCap::SharedMemoryReader::kEvent) {
+      // Summarise in place, keep the summary only if the slot stayed valid
+      Statistics update;
+      update.fSumEdep = event.GetEdep();
+      if (event.GetMultiplicity() > 0) {
+        update.fSumTotalEnergy = event.GetTotalEnergy();
+        update.fSumMultiplicity = event.GetMultiplicity();
+        for (std::size_t i = 0; i < event.GetNumberOfSecondaries(); ++i) {
+          ++update.fNofSecondaries[event.GetType(i)];
+        }
+      }
+      if (reader->Validate(event)) {
+        ++statistics.fNofEvents;
+        statistics.fSumEdep += update.fSumEdep;
+        if (update.fSumMultiplicity > 0) {
+          ++statistics.fNofCaptures;
+          statistics.fSumTotalEnergy += update.fSumTotalEnergy;
+          statistics.fSumMultiplicity += update.fSumMultiplicity;
+          for (const auto& [type, count] : update.fNofSecondaries) {
+            statistics.fNofSecondaries[type] += count;
+          }
+        }
+      }
+    }
+    else if (status == GdNCap::SharedMemoryReader::kEmpty) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto now = Clock::now();
+    double seconds = std::chrono::duration<double>(now - lastPrint).count();
+    if (seconds >= interval || status == GdNCap::SharedMemoryReader::kFinished) {
+      Print(*reader, statistics, statistics.fNofEvents - nofPrinted, seconds);
+      nofPrinted = statistics.fNofEvents;
+      lastPrint = now;
+    }
+    if (status == GdNCap::SharedMemoryReader::kFinished) break;
+  }
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,118 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/reader/include/CaptureRecordReader.hh
+/// \brief Definition of the GdNCap::CaptureRecordReader class
+
+#ifndef GdNCapCaptureRecordReader_h
+#define GdNCapCaptureRecordReader_h 1
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// Reader of the binary capture record files (CaptureRecordFormat.hh).
+///
+/// The library does not depend on Geant4. Blocks are read one at a time
+/// into plain column vectors, so a whole file never has to fit in memory:
+///
+///   GdNCap::CaptureRecordReader reader("CaptureRecords.gdnc");
+///   GdNCap::CaptureRecordColumns block;
+///   while (reader.NextBlock(block)) {
+///     for (std::size_t i = 0; i < block.GetNumberOfEvents(); ++i) {
+///       for (auto j = block.offset[i]; j < block.offset[i + 1]; ++j) {
+///         Fill(block.energy[j], reader.GetTypeName(block.type[j]));
+///       }
+///     }
+///   }
+///
+/// Errors are reported by throwing std::runtime_error.
+
+namespace GdNCap
+{
+
+/// Columns of one block of events, energies in MeV
+struct CaptureRecordColumns
+{
+  std::vector<std::int32_t> eventId;
+  std::vector<double> edep;
+  std::vector<double> totalEnergy;
+  std::vector<std::uint32_t> multiplicity;
+  std::vector<std::uint64_t> offset;   // nEvents + 1 entries into energy/type
+  std::vector<double> energy;
+  std::vector<std::uint8_t> type;
+  std::vector<double> weight;          // all 1 in version 1 files
+
+  std::size_t GetNumberOfEvents() const { return eventId.size(); }
+};
+
+class CaptureRecordReader
+{
+  public:
+    explicit CaptureRecordReader(const std::string& fileName);
+    ~CaptureRecordReader() = default;
+
+    const std::string& GetPrimaryName() const { return fPrimaryName; }
+    double GetPrimaryEnergy() const { return fPrimaryEnergy; }
+    std::uint32_t GetVersion() const { return fVersion; }
+    std::uint64_t GetNumberOfEvents() const { return fNofEvents; }
+    std::uint64_t GetNumberOfSecondaries() const { return fNofSecondaries; }
+    std::uint64_t GetNumberOfBlocks() const { return fNofBlocks; }
+    const std::vector<std::string>& GetTypeNames() const { return fTypeNames; }
+    const std::string& GetTypeName(std::uint8_t type) const;
+
+    /// Read the next block, false at the end of the file
+    bool NextBlock(CaptureRecordColumns& columns);
+
+    /// Go back to the first block
+    void Rewind();
+
+  private:
+    void Read(char* data, std::size_t size);
+
+    std::string fFileName;
+    std::ifstream fFile;
+    std::string fPrimaryName;
+    double fPrimaryEnergy = 0.;
+    std::uint32_t fVersion = 0;
+    std::uint64_t fNofEvents = 0;
+    std::uint64_t fNofSecondaries = 0;
+    std::uint64_t fNofBlocks = 0;
+    std::vector<std::string> fTypeNames;
+
+    std::uint64_t fFirstBlockOffset = 0;
+    std::uint64_t fTypeTableOffset = 0;
+    std::uint64_t fNextBlock = 0;
+    std::vector<char> fStored;
+    std::vector<char> fRaw;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
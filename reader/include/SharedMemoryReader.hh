@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/reader/include/SharedMemoryReader.hh
+/// \brief Definition of the GdNCap::SharedMemoryReader class
+
+#ifndef GdNCapSharedMemoryReader_h
+#define GdNCapSharedMemoryReader_h 1
+
+#include "SharedMemoryFormat.hh"
+
+#include <cstdint>
+#include <string>
+
+/// Consumer of the shared-memory ring published by a running
+/// GdNeutronCapture (SharedMemoryFormat.hh).
+///
+/// Events are read in place, without copying: Next() points an Event at
+/// the next complete slot, and Validate() tells afterwards whether the
+/// producer overwrote the slot while it was being read, in which case
+/// whatever was derived from it has to be discarded:
+///
+///   GdNCap::SharedMemoryReader reader("/gdncap");
+///   GdNCap::SharedMemoryReader::Event event;
+///   for (;;) {
+///     auto status = reader.Next(event);
+///     if (status == GdNCap::SharedMemoryReader::kFinished) break;
+///     if (status == GdNCap::SharedMemoryReader::kEmpty) { Sleep(); continue; }
+///     Summary summary = Summarise(event);
+///     if (reader.Validate(event)) Add(summary);
+///   }
+///
+/// Events published while the consumer is more than a ring behind are lost
+/// and counted by GetNumberOfLost(). Errors are reported by throwing
+/// std::runtime_error.
+
+namespace GdNCap
+{
+
+class SharedMemoryReader
+{
+  public:
+    enum Status { kEvent, kEmpty, kFinished };
+
+    /// Zero-copy view of one slot of the ring
+    class Event
+    {
+      public:
+        std::int32_t GetEventId() const { return fSlot->fEventId; }
+        std::uint32_t GetRunId() const { return fSlot->fRunId; }
+        double GetEdep() const { return fSlot->fEdep; }
+        double GetTotalEnergy() const { return fSlot->fTotalEnergy; }
+        std::uint32_t GetMultiplicity() const { return fSlot->fMultiplicity; }
+        /// Secondaries stored in the slot, at most the ring's maximum
+        std::uint32_t GetNumberOfSecondaries() const { return fSlot->fNofSecondaries; }
+        double GetEnergy(std::size_t i) const
+          { return SharedMemoryFormat::GetEnergies(fSlot)[i]; }
+        double GetWeight(std::size_t i) const
+          { return SharedMemoryFormat::GetWeights(fSlot, fMaxSecondaries)[i]; }
+        std::uint8_t GetType(std::size_t i) const
+          { return SharedMemoryFormat::GetTypes(fSlot, fMaxSecondaries)[i]; }
+
+      private:
+        friend class SharedMemoryReader;
+        const SharedMemoryFormat::Slot* fSlot = nullptr;
+        std::uint64_t fSequence = 0;
+        std::size_t fMaxSecondaries = 0;
+    };
+
+    /// Attach to the ring; read from its oldest complete event if
+    /// fromStart, otherwise from the events published from now on
+    explicit SharedMemoryReader(const std::string& name, bool fromStart = false);
+    ~SharedMemoryReader();
+
+    SharedMemoryReader(const SharedMemoryReader&) = delete;
+    SharedMemoryReader& operator=(const SharedMemoryReader&) = delete;
+
+    Status Next(Event& event);
+    bool Validate(const Event& event) const;
+
+    std::string GetTypeName(std::uint8_t type) const;
+    bool IsRunning() const;
+    std::uint32_t GetRunId() const;
+    std::uint64_t GetNumberOfLost() const { return fNofLost; }
+    std::uint64_t GetNumberOfSlots() const { return fHeader->fNofSlots; }
+    std::uint32_t GetProducerPid() const { return fHeader->fProducerPid; }
+
+  private:
+    const SharedMemoryFormat::Slot* GetSlot(std::uint64_t pos) const;
+
+    std::size_t fSize = 0;
+    const SharedMemoryFormat::RingHeader* fHeader = nullptr;
+    const char* fSlots = nullptr;
+    std::uint64_t fReadPos = 0;
+    std::uint64_t fNofLost = 0;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,202 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/reader/src/CaptureRecordReader.cc
+/// \brief Implementation of the GdNCap::CaptureRecordReader class
+
+#include "CaptureRecordReader.hh"
+#include "CaptureRecordFormat.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+#ifdef GDNCAP_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace
+{
+  template <typename T>
+  const char* ReadColumn(const char* in, std::vector<T>& column, std::size_t size)
+  {
+    column.resize(size);
+    if (size > 0) std::memcpy(column.data(), in, size * sizeof(T));
+    return in + size * sizeof(T);
+  }
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureRecordReader::CaptureRecordReader(const std::string& fileName)
+: fFileName(fileName),
+  fFile(fileName, std::ios_base::in | std::ios_base::binary)
+{
+  if (!fFile) throw std::runtime_error("Cannot open " + fileName);
+
+  RecordFormat::FileHeader header;
+  Read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (std::memcmp(header.fMagic, RecordFormat::kFileMagic, sizeof(header.fMagic)) != 0) {
+    throw std::runtime_error(fileName + " is not a capture record file");
+  }
+  if (header.fVersion < 1 || header.fVersion > RecordFormat::kVersion) {
+    throw std::runtime_error(fileName + ": unsupported format version "
+                             + std::to_string(header.fVersion));
+  }
+  fVersion = header.fVersion;
+  fPrimaryEnergy = header.fPrimaryEnergy;
+  fPrimaryName.resize(header.fPrimaryNameLength);
+  Read(&fPrimaryName[0], fPrimaryName.size());
+  fFirstBlockOffset = static_cast<std::uint64_t>(fFile.tellg());
+
+  RecordFormat::Footer footer;
+  fFile.seekg(-static_cast<std::streamoff>(sizeof(footer)), std::ios_base::end);
+  Read(reinterpret_cast<char*>(&footer), sizeof(footer));
+  if (std::memcmp(footer.fMagic, RecordFormat::kFooterMagic, sizeof(footer.fMagic)) != 0) {
+    throw std::runtime_error(fileName + " is truncated (no footer)");
+  }
+  fNofEvents = footer.fNofEvents;
+  fNofSecondaries = footer.fNofSecondaries;
+  fNofBlocks = footer.fNofBlocks;
+  fTypeTableOffset = footer.fTypeTableOffset;
+
+  fFile.seekg(fTypeTableOffset);
+  std::uint32_t nofTypes = 0;
+  Read(reinterpret_cast<char*>(&nofTypes), sizeof(nofTypes));
+  fTypeNames.resize(nofTypes);
+  for (auto& name : fTypeNames) {
+    std::uint32_t length = 0;
+    Read(reinterpret_cast<char*>(&length), sizeof(length));
+    name.resize(length);
+    Read(&name[0], length);
+  }
+
+  Rewind();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::string& CaptureRecordReader::GetTypeName(std::uint8_t type) const
+{
+  static const std::string unknown = "unknown";
+  return type < fTypeNames.size() ? fTypeNames[type] : unknown;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureRecordReader::Read(char* data, std::size_t size)
+{
+  fFile.read(data, size);
+  if (static_cast<std::size_t>(fFile.gcount()) != size) {
+    throw std::runtime_error("Unexpected end of " + fFileName);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureRecordReader::Rewind()
+{
+  fFile.clear();
+  fFile.seekg(fFirstBlockOffset);
+  fNextBlock = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool CaptureRecordReader::NextBlock(CaptureRecordColumns& columns)
+{
+  if (fNextBlock == fNofBlocks) return false;
+
+  RecordFormat::BlockHeader header;
+  Read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (std::memcmp(header.fMagic, RecordFormat::kBlockMagic, sizeof(header.fMagic)) != 0) {
+    throw std::runtime_error(fFileName + ": corrupted block "
+                             + std::to_string(fNextBlock));
+  }
+  if (header.fRawSize != RecordFormat::GetRawSize(header.fNofEvents, header.fNofSecondaries,
+                                                     fVersion)) {
+    throw std::runtime_error(fFileName + ": inconsistent size of block "
+                             + std::to_string(fNextBlock));
+  }
+
+  const char* raw = nullptr;
+  if (header.fCompression == RecordFormat::kNone) {
+    fRaw.resize(header.fStoredSize);
+    Read(fRaw.data(), fRaw.size());
+    raw = fRaw.data();
+  }
+  else if (header.fCompression == RecordFormat::kZlib) {
+#ifdef GDNCAP_USE_ZLIB
+    fStored.resize(header.fStoredSize);
+    Read(fStored.data(), fStored.size());
+    fRaw.resize(header.fRawSize);
+    uLongf rawSize = header.fRawSize;
+    int status = uncompress(reinterpret_cast<Bytef*>(fRaw.data()), &rawSize,
+                            reinterpret_cast<const Bytef*>(fStored.data()), fStored.size());
+    if (status != Z_OK || rawSize != header.fRawSize) {
+      throw std::runtime_error(fFileName + ": cannot decompress block "
+                               + std::to_string(fNextBlock));
+    }
+    raw = fRaw.data();
+#else
+    throw std::runtime_error(fFileName + " has compressed blocks, rebuild the reader with zlib");
+#endif
+  }
+  else {
+    throw std::runtime_error(fFileName + ": unknown compression of block "
+                             + std::to_string(fNextBlock));
+  }
+
+  const std::size_t nofEvents = header.fNofEvents;
+  const std::size_t nofSecondaries = header.fNofSecondaries;
+  raw = ReadColumn(raw, columns.eventId, nofEvents);
+  raw = ReadColumn(raw, columns.edep, nofEvents);
+  raw = ReadColumn(raw, columns.totalEnergy, nofEvents);
+  raw = ReadColumn(raw, columns.multiplicity, nofEvents);
+  raw = ReadColumn(raw, columns.energy, nofSecondaries);
+  raw = ReadColumn(raw, columns.type, nofSecondaries);
+  if (fVersion >= 2) ReadColumn(raw, columns.weight, nofSecondaries);
+  else columns.weight.assign(nofSecondaries, 1.);
+
+  columns.offset.resize(nofEvents + 1);
+  columns.offset[0] = 0;
+  for (std::size_t i = 0; i < nofEvents; ++i) {
+    columns.offset[i + 1] = columns.offset[i] + columns.multiplicity[i];
+  }
+  if (columns.offset[nofEvents] != nofSecondaries) {
+    throw std::runtime_error(fFileName + ": inconsistent multiplicities in block "
+                             + std::to_string(fNextBlock));
+  }
+
+  ++fNextBlock;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,151 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/reader/src/SharedMemoryReader.cc
+/// \brief Implementation of the GdNCap::SharedMemoryReader class
+
+#include "SharedMemoryReader.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace GdNCap
+{
+
+using namespace SharedMemoryFormat;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SharedMemoryReader::SharedMemoryReader(const std::string& name, bool fromStart)
+{
+  const std::string shmName = name.empty() || name[0] != '/' ? "/" + name : name;
+  int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+  if (fd < 0) throw std::runtime_error("Cannot open shared memory " + shmName);
+
+  struct stat status;
+  void* address = MAP_FAILED;
+  if (fstat(fd, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(RingHeader))) {
+    fSize = status.st_size;
+    address = mmap(nullptr, fSize, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (address == MAP_FAILED) throw std::runtime_error("Cannot map shared memory " + shmName);
+
+  fHeader = static_cast<const RingHeader*>(address);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (std::memcmp(fHeader->fMagic, kMagic, sizeof(fHeader->fMagic)) != 0
+      || fHeader->fVersion != kVersion
+      || fHeader->fHeaderSize + fHeader->fNofSlots * fHeader->fSlotSize > fSize) {
+    munmap(address, fSize);
+    throw std::runtime_error(shmName + " is not a capture record ring");
+  }
+  fSlots = static_cast<const char*>(address) + fHeader->fHeaderSize;
+
+  std::uint64_t writePos = fHeader->fWritePos.load(std::memory_order_acquire);
+  if (!fromStart) fReadPos = writePos;
+  else if (writePos > fHeader->fNofSlots) fReadPos = writePos - fHeader->fNofSlots;
+}
+
+SharedMemoryReader::~SharedMemoryReader()
+{
+  munmap(const_cast<RingHeader*>(fHeader), fSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const Slot* SharedMemoryReader::GetSlot(std::uint64_t pos) const
+{
+  return reinterpret_cast<const Slot*>(
+    fSlots + (pos & (fHeader->fNofSlots - 1)) * fHeader->fSlotSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SharedMemoryReader::Status SharedMemoryReader::Next(Event& event)
+{
+  for (;;) {
+    const Slot* slot = GetSlot(fReadPos);
+    const std::uint64_t complete = 2 * fReadPos + 2;
+    const std::uint64_t sequence = slot->fSequence.load(std::memory_order_acquire);
+
+    if (sequence == complete) {
+      event.fSlot = slot;
+      event.fSequence = sequence;
+      event.fMaxSecondaries = fHeader->fMaxSecondaries;
+      ++fReadPos;
+      return kEvent;
+    }
+    if (sequence < complete) {
+      // Not yet published, or being written
+      if (fHeader->fState.load(std::memory_order_acquire) == kFinished
+          && fReadPos >= fHeader->fWritePos.load(std::memory_order_acquire)) {
+        return kFinished;
+      }
+      return kEmpty;
+    }
+
+    // The slot was reused: skip to the oldest event still in the ring
+    std::uint64_t writePos = fHeader->fWritePos.load(std::memory_order_acquire);
+    std::uint64_t oldest = writePos > fHeader->fNofSlots ? writePos - fHeader->fNofSlots : 0;
+    if (oldest <= fReadPos) oldest = fReadPos + 1;
+    fNofLost += oldest - fReadPos;
+    fReadPos = oldest;
+  }
+}
+
+bool SharedMemoryReader::Validate(const Event& event) const
+{
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return event.fSlot->fSequence.load(std::memory_order_relaxed) == event.fSequence;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string SharedMemoryReader::GetTypeName(std::uint8_t type) const
+{
+  if (type >= fHeader->fNofTypes.load(std::memory_order_acquire)) return "?";
+  const char* name = fHeader->fTypeNames[type];
+  return std::string(name, strnlen(name, kTypeNameLength));
+}
+
+bool SharedMemoryReader::IsRunning() const
+{
+  return fHeader->fState.load(std::memory_order_acquire) == kRunning;
+}
+
+std::uint32_t SharedMemoryReader::GetRunId() const
+{
+  return fHeader->fRunId.load(std::memory_order_acquire);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
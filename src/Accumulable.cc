@@ -2,33 +2,125 @@
 
 namespace GdNCap
 {
-	Accumulable::Accumulable() :G4VAccumulable() {}
-	Accumulable::~Accumulable() 
-	{
-		secondariesList.clear();
-	}
+	Accumulable::Accumulable(std::size_t blockCapacity)
+	: G4VAccumulable(), fBlockCapacity(blockCapacity),
+	  fOpenBlock(std::make_shared<CaptureRecordBlock>(blockCapacity))
+	{}
 
 	void Accumulable::Merge(const G4VAccumulable& other)
 	{
-		const Accumulable& otherMatrix = static_cast<const Accumulable&>(other);
-		std::list<std::vector<std::pair<G4double, G4String>>> secListTemp = otherMatrix.secondariesList;
-		std::list<G4double> secEnergyTemp = otherMatrix.secondariesEnergy;
-		secondariesList.merge(secListTemp);
-		secondariesEnergy.merge(secEnergyTemp);
+		const Accumulable& otherRecords = static_cast<const Accumulable&>(other);
+		// Splice the other store's sequences; the records themselves are shared, not copied
+		fSequences.insert(fSequences.end(), otherRecords.fSequences.begin(), otherRecords.fSequences.end());
+		if (!otherRecords.fOpenBlock->IsEmpty())
+		{
+			Append(fSequences, otherRecords.fOpenBlock);
+		}
 	}
 
 	void Accumulable::Reset()
 	{
-		secondariesList.clear();
-		secondariesEnergy.clear();
+		// Blocks may still be referenced by a store this one was merged into,
+		// so start from fresh ones instead of clearing them
+		fSequences.clear();
+		fOpenBlock = std::make_shared<CaptureRecordBlock>(fBlockCapacity);
+	}
+
+	void Accumulable::Append(std::vector<Sequence>& sequences, BlockHandle block)
+	{
+		if (!block->IsSorted())
+		{
+			block = std::make_shared<const CaptureRecordBlock>(block->SortedByEventId());
+		}
+		// Continue the last sequence while the event IDs keep increasing
+		if (sequences.empty() || sequences.back().back()->GetLastEventId() >= block->GetFirstEventId())
+		{
+			sequences.emplace_back();
+		}
+		sequences.back().push_back(std::move(block));
+	}
+
+	CaptureRecordView Accumulable::GetView() const
+	{
+		std::vector<Sequence> sequences = fSequences;
+		if (!fOpenBlock->IsEmpty())
+		{
+			// Sorted in place: a sorted copy made by Append() would only be
+			// owned by the local sequences, and the view keeps raw pointers
+			if (!fOpenBlock->IsSorted())
+			{
+				*fOpenBlock = fOpenBlock->SortedByEventId();
+			}
+			Append(sequences, fOpenBlock);
+		}
+
+		std::vector<CaptureRecordView::Sequence> viewSequences(sequences.size());
+		for (std::size_t i = 0; i < sequences.size(); ++i)
+		{
+			for (const auto& block : sequences[i])
+			{
+				viewSequences[i].push_back(block.get());
+			}
+		}
+		return CaptureRecordView(std::move(viewSequences));
+	}
+
+	std::size_t Accumulable::GetMemoryUsage() const
+	{
+		std::size_t bytes = fOpenBlock->GetMemoryUsage();
+		for (const auto& sequence : fSequences)
+		{
+			bytes += sequence.capacity() * sizeof(BlockHandle);
+			for (const auto& block : sequence)
+			{
+				bytes += block->GetMemoryUsage();
+			}
+		}
+		return bytes + fSequences.capacity() * sizeof(Sequence);
+	}
+
+	void Accumulable::AddEvent(G4int eventId, G4double edep, G4double totalEnergy,
+	                           const std::vector<G4double>& energies,
+	                           const std::vector<CaptureRecordBlock::TypeId>& types,
+	                           const std::vector<G4double>& weights)
+	{
+		fOpenBlock->AddEvent(eventId, edep, totalEnergy, energies, types, weights);
+		if (!fOpenBlock->IsFull())
+		{
+			return;
+		}
+		if (fBlockSink)
+		{
+			SinkOpenBlock();
+		}
+		else
+		{
+			Append(fSequences, std::move(fOpenBlock));
+			fOpenBlock = std::make_shared<CaptureRecordBlock>(fBlockCapacity);
+		}
 	}
-	
-	void Accumulable::PushSecondariesList(std::vector<std::pair<G4double, G4String>> fSecondaries)
+
+	void Accumulable::SetBlockCapacity(std::size_t capacity)
 	{
-		secondariesList.push_back(fSecondaries);
+		fBlockCapacity = capacity;
+		Reset();
 	}
-	void Accumulable::PushSecondariesEnergy(G4double fSecE)
+
+	void Accumulable::Flush()
+	{
+		if (fBlockSink && !fOpenBlock->IsEmpty())
+		{
+			SinkOpenBlock();
+		}
+	}
+
+	void Accumulable::SinkOpenBlock()
 	{
-		secondariesEnergy.push_back(fSecE);
+		if (!fOpenBlock->IsSorted())
+		{
+			*fOpenBlock = fOpenBlock->SortedByEventId();
+		}
+		fBlockSink(*fOpenBlock);
+		fOpenBlock->Clear();
 	}
-}
\ No newline at end of file
+}
@@ -32,12 +32,21 @@
 #include "RunAction.hh"
 #include "EventAction.hh"
 #include "SteppingAction.hh"
+#include "TrackingAction.hh"
+#include "StackingAction.hh"
+#include "DetectorConstruction.hh"
 
 namespace GdNCap
 {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+ActionInitialization::ActionInitialization(const DetectorConstruction* detConstruction)
+: fDetConstruction(detConstruction)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void ActionInitialization::BuildForMaster() const
 {
   auto runAction = new RunAction;
@@ -56,7 +65,18 @@ void ActionInitialization::Build() const
   auto eventAction = new EventAction(runAction);
   SetUserAction(eventAction);
 
-  SetUserAction(new SteppingAction(eventAction));
+  if (fDetConstruction->GetScoringMode()
+      == DetectorConstruction::ScoringMode::SensitiveDetector) {
+    // EnvelopeSD scores the energy deposit
+    SetUserAction(new TrackingAction(eventAction, runAction->GetCaptureFilter()));
+  }
+  else {
+    SetUserAction(new SteppingAction(eventAction, runAction->GetCaptureFilter(),
+                                     runAction->GetStepProfiler()));
+  }
+
+  // Kills the secondaries in the capture-only transport modes
+  SetUserAction(new StackingAction(runAction->GetCaptureFilter()));
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
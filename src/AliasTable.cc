@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/src/AliasTable.cc
+/// \brief Implementation of the GdNCap::AliasTable class
+
+#include "AliasTable.hh"
+
+#include <cmath>
+#include <numeric>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool AliasTable::Build(const std::vector<G4double>& weights)
+{
+  fProbabilities.clear();
+  fAliases.clear();
+
+  G4double sum = 0.;
+  for (G4double weight : weights) {
+    if (!std::isfinite(weight) || weight < 0.) return false;
+    sum += weight;
+  }
+  if (!(sum > 0.) || !std::isfinite(sum)) return false;
+
+  // Probabilities scaled so that their mean is 1, split into the indices
+  // below and above the mean
+  const std::size_t n = weights.size();
+  std::vector<G4double> scaled(n);
+  std::vector<std::uint32_t> small, large;
+  for (std::size_t i = 0; i < n; ++i) {
+    scaled[i] = weights[i] * n / sum;
+    (scaled[i] < 1. ? small : large).push_back(static_cast<std::uint32_t>(i));
+  }
+
+  // Each small index is topped up to 1 by a large one, its alias
+  fProbabilities.assign(n, 1.);
+  fAliases.resize(n);
+  std::iota(fAliases.begin(), fAliases.end(), 0u);
+  while (!small.empty() && !large.empty()) {
+    const std::uint32_t less = small.back();
+    small.pop_back();
+    const std::uint32_t more = large.back();
+    fProbabilities[less] = scaled[less];
+    fAliases[less] = more;
+    scaled[more] -= 1. - scaled[less];
+    if (scaled[more] < 1.) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+  // What is left is 1 up to the rounding errors, and keeps probability 1
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
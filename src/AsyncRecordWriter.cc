@@ -0,0 +1,230 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/AsyncRecordWriter.cc
+/// \brief Implementation of the GdNCap::AsyncRecordWriter class
+
+#include "AsyncRecordWriter.hh"
+
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+  G4Mutex primaryMutex = G4MUTEX_INITIALIZER;
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AsyncRecordWriter::AsyncRecordWriter(std::unique_ptr<VRecordWriter> writer,
+                                     std::size_t queueCapacity)
+: fWriter(std::move(writer)), fQueue(queueCapacity), fMaxHeld(fQueue.GetCapacity())
+{}
+
+AsyncRecordWriter::~AsyncRecordWriter()
+{
+  Stop();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncRecordWriter::Start(G4int nofProducers, const G4String& suffix)
+{
+  Stop();
+  fSuffix = suffix;
+  fPrimarySet = false;
+  fPending.assign(std::max(nofProducers, 1), {});
+  fNofProducers = fPending.size();
+  fNofHeldBy = std::make_unique<std::atomic<std::size_t>[]>(fNofProducers);
+  for (std::size_t i = 0; i < fNofProducers; ++i) fNofHeldBy[i] = 0;
+  fNofHeld = 0;
+  fBlock.Clear();
+  fNextEventId = 0;
+  fNofPending = 0;
+  fMaxPending = 0;
+  fNofStalls = 0;
+  fStopping = false;
+  fThread = std::thread(&AsyncRecordWriter::Run, this);
+}
+
+void AsyncRecordWriter::SetPrimary(const G4String& particleName, G4double energy)
+{
+  G4AutoLock lock(&primaryMutex);
+  if (fPrimarySet) return;
+  fPrimaryName = particleName;
+  fPrimaryEnergy = energy;
+  fPrimarySet = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncRecordWriter::Push(G4int producer, G4int eventId, G4double edep,
+                             G4double totalEnergy,
+                             const std::vector<G4double>& energies,
+                             const std::vector<RecordQueue::TypeId>& types,
+                             const std::vector<G4double>& weights)
+{
+  // Bound of the reordering: wait for the I/O thread to emit records while
+  // this producer has some held and the cap is reached
+  G4bool stalled = false;
+  std::atomic<std::size_t>* nofHeldBy = nullptr;
+  if (producer >= 0 && static_cast<std::size_t>(producer) < fNofProducers) {
+    nofHeldBy = &fNofHeldBy[producer];
+    while (fNofHeld.load(std::memory_order_acquire) >= fMaxHeld
+           && nofHeldBy->load(std::memory_order_acquire) > 0) {
+      stalled = true;
+      std::this_thread::yield();
+    }
+    nofHeldBy->fetch_add(1, std::memory_order_relaxed);
+  }
+  fNofHeld.fetch_add(1, std::memory_order_relaxed);
+
+  // Backpressure: wait for the I/O thread to free a cell
+  while (!fQueue.TryPush(producer, eventId, edep, totalEnergy, energies, types, weights)) {
+    stalled = true;
+    std::this_thread::yield();
+  }
+  if (stalled) fNofStalls.fetch_add(1, std::memory_order_relaxed);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncRecordWriter::Stop()
+{
+  if (!fThread.joinable()) return;
+  fStopping.store(true, std::memory_order_release);
+  fThread.join();
+  fWriter->Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncRecordWriter::Run()
+{
+  for (;;) {
+    // Read the flag first: every push made before Stop() is then visible
+    // to the drain that follows
+    G4bool stopping = fStopping.load(std::memory_order_acquire);
+    G4bool popped = false;
+    Drain(popped);
+    EmitReady(false);
+    if (stopping) break;
+    if (!popped) std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  EmitReady(true);
+  if (!fBlock.IsEmpty()) {
+    fWriter->Write(fBlock);
+    fBlock.Clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncRecordWriter::Drain(G4bool& popped)
+{
+  while (fQueue.TryPop(fRecord)) {
+    popped = true;
+    auto producer = static_cast<std::size_t>(std::max(fRecord.fProducer, 0));
+    if (producer >= fPending.size()) fPending.resize(producer + 1);
+    fPending[producer].push_back(std::move(fRecord));
+    fMaxPending = std::max(++fNofPending, fMaxPending);
+
+    // Hand recycled vectors back to the queue with the next pop
+    if (!fFreeRecords.empty()) {
+      fRecord = std::move(fFreeRecords.back());
+      fFreeRecords.pop_back();
+    }
+    else {
+      fRecord = RecordQueue::Record();
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AsyncRecordWriter::EmitReady(G4bool all)
+{
+  for (;;) {
+    std::deque<RecordQueue::Record>* next = nullptr;
+    G4bool allPending = true;
+    for (auto& pending : fPending) {
+      if (pending.empty()) {
+        allPending = false;
+        continue;
+      }
+      if (pending.front().fEventId == fNextEventId) {
+        next = &pending;
+        break;
+      }
+      if (!next || pending.front().fEventId < next->front().fEventId) next = &pending;
+    }
+    if (!next) return;
+
+    // A smaller event ID may still come from a producer with nothing pending
+    if (next->front().fEventId != fNextEventId && !allPending && !all) return;
+    Emit(*next);
+  }
+}
+
+void AsyncRecordWriter::Emit(std::deque<RecordQueue::Record>& pending)
+{
+  if (!fWriter->IsOpen()) OpenWriter();
+
+  auto& record = pending.front();
+  fBlock.AddEvent(record.fEventId, record.fEdep, record.fTotalEnergy,
+                  record.fEnergies, record.fTypes, record.fWeights);
+  if (fBlock.IsFull()) {
+    fWriter->Write(fBlock);
+    fBlock.Clear();
+  }
+
+  fNextEventId = record.fEventId + 1;
+  if (record.fProducer >= 0 && static_cast<std::size_t>(record.fProducer) < fNofProducers) {
+    fNofHeldBy[record.fProducer].fetch_sub(1, std::memory_order_release);
+  }
+  fNofHeld.fetch_sub(1, std::memory_order_release);
+  fFreeRecords.push_back(std::move(record));
+  pending.pop_front();
+  --fNofPending;
+}
+
+void AsyncRecordWriter::OpenWriter()
+{
+  // The producer of the first record set the primary before pushing it
+  G4AutoLock lock(&primaryMutex);
+  fWriter->SetPrimary(fPrimaryName, fPrimaryEnergy);
+  fWriter->Open(fSuffix);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
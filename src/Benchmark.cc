@@ -0,0 +1,232 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/Benchmark.cc
+/// \brief Implementation of the GdNCap::Benchmark class
+
+#include "Benchmark.hh"
+#include "RunSummary.hh"
+
+#include "G4Threading.hh"
+#include "G4Version.hh"
+
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define GDNCAP_HAVE_GETHOSTNAME 1
+#endif
+
+namespace
+{
+  G4String GetHostName()
+  {
+#ifdef GDNCAP_HAVE_GETHOSTNAME
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) == 0) return name;
+#endif
+    return "unknown";
+  }
+
+  // Strings of the results are names and paths, only quotes and
+  // backslashes need escaping
+  G4String Quote(const G4String& text)
+  {
+    G4String quoted = "\"";
+    for (char c : text) {
+      if (c == '"' || c == '\\') quoted += '\\';
+      quoted += c;
+    }
+    return quoted + "\"";
+  }
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+Benchmark::Benchmark(const G4String& program, const std::vector<G4String>& macros,
+                     const std::vector<G4String>& arguments)
+: fChild(program), fArguments(arguments)
+{
+  for (const auto& macro : macros) fMacros.push_back(ChildProcess::GetAbsolutePath(macro));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool Benchmark::Run(G4int maxThreads, const G4String& fileName)
+{
+  std::vector<G4int> threads;
+  for (G4int n = 1; n < maxThreads; n *= 2) threads.push_back(n);
+  threads.push_back(maxThreads);
+
+  G4bool succeeded = true;
+  std::vector<Workload> workloads;
+  for (const auto& macro : fMacros) {
+    Workload workload;
+    workload.fMacro = macro;
+    workload.fName = std::filesystem::path(macro.c_str()).stem().string();
+    if (workload.fName.rfind("bench_", 0) == 0) workload.fName.erase(0, 6);
+
+    for (auto nofThreads : threads) {
+      G4cout << " Benchmark " << workload.fName << " on " << nofThreads
+             << " threads ..." << G4endl;
+      Measurement measurement;
+      measurement.fNofThreads = nofThreads;
+      const G4String directory = "bench_" + workload.fName + "_" + std::to_string(nofThreads);
+      std::vector<G4String> arguments = fArguments;
+      arguments.insert(arguments.end(), { "-j", std::to_string(nofThreads),
+                                          "-r", "summary.txt", macro });
+      measurement.fSucceeded = fChild.Run(arguments, directory);
+      measurement.fPeakMemory = fChild.GetPeakMemory();
+      succeeded = succeeded && measurement.fSucceeded;
+      if (measurement.fSucceeded) {
+        const auto totals = RunSummary::GetTotals(RunSummary::Read(directory + "/summary.txt"));
+        measurement.fInitTime = totals.fInitTime;
+        measurement.fNofEvents = totals.fLastRunEvents;
+        measurement.fEventTime = totals.fLastRunTime;
+        if (totals.fLastRunTime > 0.) {
+          measurement.fEventsPerSecond = totals.fLastRunEvents / totals.fLastRunTime;
+        }
+        measurement.fOutputSize = GetOutputSize(directory);
+      }
+      const auto& single = workload.fMeasurements.empty() ? measurement
+                                                          : workload.fMeasurements.front();
+      if (single.fEventsPerSecond > 0.) {
+        measurement.fEfficiency =
+          measurement.fEventsPerSecond / (nofThreads * single.fEventsPerSecond);
+      }
+      workload.fMeasurements.push_back(measurement);
+    }
+    workloads.push_back(workload);
+  }
+
+  Write(fileName, workloads);
+
+  G4cout
+    << G4endl
+    << "--------------------Benchmark-------------------------------"
+    << G4endl
+    << " " << std::left << std::setw(12) << "workload" << std::right
+    << std::setw(8) << "threads" << std::setw(10) << "init[s]"
+    << std::setw(12) << "events/s" << std::setw(8) << "eff."
+    << std::setw(12) << "memory[MB]" << std::setw(12) << "output[MB]" << G4endl;
+  const auto precision = G4cout.precision(4);
+  for (const auto& workload : workloads) {
+    for (const auto& measurement : workload.fMeasurements) {
+      G4cout
+        << " " << std::left << std::setw(12) << workload.fName << std::right
+        << std::setw(8) << measurement.fNofThreads;
+      if (!measurement.fSucceeded) {
+        G4cout << "  failed, see bench_" << workload.fName << "_"
+               << measurement.fNofThreads << "/log.txt" << G4endl;
+        continue;
+      }
+      G4cout
+        << std::setw(10) << measurement.fInitTime
+        << std::setw(12) << measurement.fEventsPerSecond
+        << std::setw(8) << measurement.fEfficiency
+        << std::setw(12) << measurement.fPeakMemory
+        << std::setw(12) << measurement.fOutputSize / 1048576. << G4endl;
+    }
+  }
+  G4cout.precision(precision);
+  G4cout
+    << " written to " << fileName << G4endl
+    << "------------------------------------------------------------"
+    << G4endl;
+  return succeeded;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::uint64_t Benchmark::GetOutputSize(const G4String& directory)
+{
+  namespace fs = std::filesystem;
+  std::uint64_t size = 0;
+  std::error_code error;
+  for (auto it = fs::recursive_directory_iterator(directory.c_str(), error);
+       !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+    const auto name = it->path().filename();
+    if (!it->is_regular_file() || name == "log.txt" || name == "summary.txt") continue;
+    size += it->file_size();
+  }
+  return size;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Benchmark::Write(const G4String& fileName, const std::vector<Workload>& workloads) const
+{
+  char date[32] = {};
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+  G4String arguments;
+  for (const auto& argument : fArguments) {
+    arguments += (arguments.empty() ? "" : " ") + argument;
+  }
+
+  std::ofstream file(fileName);
+  file << std::setprecision(6)
+       << "{\n"
+       << "  \"date\": " << Quote(date) << ",\n"
+       << "  \"host\": " << Quote(GetHostName()) << ",\n"
+       << "  \"cores\": " << G4Threading::G4GetNumberOfCores() << ",\n"
+       << "  \"geant4\": " << G4VERSION_NUMBER << ",\n"
+       << "  \"arguments\": " << Quote(arguments) << ",\n"
+       << "  \"workloads\": [";
+  for (std::size_t i = 0; i < workloads.size(); ++i) {
+    const auto& workload = workloads[i];
+    file << (i == 0 ? "\n" : ",\n")
+         << "    {\n"
+         << "      \"name\": " << Quote(workload.fName) << ",\n"
+         << "      \"macro\": " << Quote(workload.fMacro) << ",\n"
+         << "      \"runs\": [";
+    for (std::size_t j = 0; j < workload.fMeasurements.size(); ++j) {
+      const auto& measurement = workload.fMeasurements[j];
+      file << (j == 0 ? "\n" : ",\n")
+           << "        { \"threads\": " << measurement.fNofThreads
+           << ", \"succeeded\": " << (measurement.fSucceeded ? "true" : "false")
+           << ", \"initTime\": " << measurement.fInitTime
+           << ", \"events\": " << measurement.fNofEvents
+           << ", \"eventTime\": " << measurement.fEventTime
+           << ", \"eventsPerSecond\": " << measurement.fEventsPerSecond
+           << ", \"efficiency\": " << measurement.fEfficiency
+           << ", \"peakRSS\": " << measurement.fPeakMemory
+           << ", \"outputBytes\": " << measurement.fOutputSize << " }";
+    }
+    file << "\n      ]\n    }";
+  }
+  file << "\n  ]\n}\n";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
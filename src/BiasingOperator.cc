@@ -0,0 +1,230 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/BiasingOperator.cc
+/// \brief Implementation of the GdNCap::BiasingOperator class
+
+#include "BiasingOperator.hh"
+#include "RunAction.hh"
+#include "CaptureFilter.hh"
+#include "RouletteOperation.hh"
+
+#include "G4BOptrForceCollision.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4BOptnCloning.hh"
+#include "G4BiasingProcessInterface.hh"
+#include "G4BiasingProcessSharedData.hh"
+#include "G4Neutron.hh"
+#include "G4ProcessManager.hh"
+#include "G4RunManager.hh"
+#include "G4Track.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+BiasingOperator::BiasingOperator(const DetectorConstruction* detConstruction)
+: G4VBiasingOperator("GdNCapBiasingOperator"),
+  fDetConstruction(detConstruction)
+{
+  // Operators have to exist before the run starts, even if not used
+  fForceCollision = new G4BOptrForceCollision("neutron", "GdNCapForceCollision");
+  fCloning = new G4BOptnCloning("GdNCapSplitting");
+  fRoulette = new RouletteOperation("GdNCapRoulette");
+}
+
+BiasingOperator::~BiasingOperator()
+{
+  for (const auto& [process, operation] : fImplicitCaptures) delete operation;
+  delete fRoulette;
+  delete fCloning;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void BiasingOperator::StartRun()
+{
+  fNeutron = G4Neutron::Definition();
+
+  // The capture filter of this thread is resolved at the start of each
+  // run, before the first step
+  if (!fCaptureFilter) {
+    const auto runAction = static_cast<const RunAction*>(
+      G4RunManager::GetRunManager()->GetUserRunAction());
+    if (runAction) fCaptureFilter = runAction->GetCaptureFilter();
+  }
+
+  // One cross-section change per biased neutron process
+  if (fImplicitCaptures.empty()) {
+    const auto sharedData =
+      G4BiasingProcessInterface::GetSharedData(fNeutron->GetProcessManager());
+    if (sharedData) {
+      for (auto wrapper : sharedData->GetPhysicsBiasingProcessInterfaces()) {
+        fImplicitCaptures[wrapper] = new G4BOptnChangeCrossSection(
+          "GdNCapImplicitCapture-" + wrapper->GetWrappedProcess()->GetProcessName());
+      }
+    }
+  }
+}
+
+void BiasingOperator::StartTracking(const G4Track*)
+{
+  fCell = -1;
+  fRoulette->Reset();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool BiasingOperator::Biases(DetectorConstruction::BiasingMode mode,
+                               const G4Track* track) const
+{
+  return fDetConstruction->GetBiasingMode() == mode
+      && track->GetParticleDefinition() == fNeutron;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VBiasingOperation* BiasingOperator::ProposeNonPhysicsBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  using BiasingMode = DetectorConstruction::BiasingMode;
+  if (Biases(BiasingMode::ForceCollision, track)) {
+    return fForceCollision->GetProposedNonPhysicsBiasingOperation(track, callingProcess);
+  }
+  if (Biases(BiasingMode::ImplicitCapture, track)) {
+    // Decided at the end of each step, on the weight reduced along it
+    if (fDetConstruction->GetRouletteThreshold() <= 0.) return nullptr;
+    fRoulette->SetWeights(fDetConstruction->GetRouletteThreshold(),
+                          fDetConstruction->GetRouletteSurvival());
+    return fRoulette;
+  }
+  if (!Biases(BiasingMode::Splitting, track)) return nullptr;
+
+  // Called once per step, before it is limited; the clone is produced at
+  // the end of the step, where it starts in the same cell
+  const G4double depth = fDetConstruction->GetDepth(track->GetTouchable(), track->GetPosition());
+  const auto cell = static_cast<G4int>(std::floor(depth / fDetConstruction->GetSplitLength()));
+  if (fCell < 0 || cell <= fCell) {
+    fCell = std::max(fCell, cell);
+    return nullptr;
+  }
+  fCell = cell;
+  const G4double weight = track->GetWeight();
+  fCloning->SetCloneWeights(0.5 * weight, 0.5 * weight);
+  return fCloning;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VBiasingOperation* BiasingOperator::ProposeOccurenceBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  using BiasingMode = DetectorConstruction::BiasingMode;
+  if (Biases(BiasingMode::ForceCollision, track)) {
+    return fForceCollision->GetProposedOccurenceBiasingOperation(track, callingProcess);
+  }
+  if (!Biases(BiasingMode::ImplicitCapture, track)) return nullptr;
+  if (!fCaptureFilter || !fCaptureFilter->IsCaptureProcess(callingProcess)) return nullptr;
+
+  auto operation = fImplicitCaptures[callingProcess];
+  if (!operation) return nullptr;
+
+  // Without a capture, the weight carries the analog non-interaction
+  // probability of every step; the interaction length is resampled only
+  // when the operation is first used by this track
+  const G4double analogInteractionLength =
+    callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if (analogInteractionLength > DBL_MAX / 10.) return nullptr;
+  if (callingProcess->GetPreviousOccurenceBiasingOperation() != operation
+      || operation->GetInteractionOccured()) {
+    operation->SetBiasedCrossSection(0.);
+    operation->Sample();
+  }
+  else {
+    operation->UpdateForStep(callingProcess->GetPreviousStepSize());
+    operation->SetBiasedCrossSection(0.);
+    operation->UpdateForStep(0.);
+  }
+  return operation;
+}
+
+G4VBiasingOperation* BiasingOperator::ProposeFinalStateBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  if (Biases(DetectorConstruction::BiasingMode::ForceCollision, track)) {
+    return fForceCollision->GetProposedFinalStateBiasingOperation(track, callingProcess);
+  }
+  return nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void BiasingOperator::OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                       G4BiasingAppliedCase biasingCase,
+                                       G4VBiasingOperation* operationApplied,
+                                       const G4VParticleChange* particleChangeProduced)
+{
+  if (fDetConstruction->GetBiasingMode() == DetectorConstruction::BiasingMode::ForceCollision) {
+    fForceCollision->ReportOperationApplied(callingProcess, biasingCase,
+                                            operationApplied, particleChangeProduced);
+  }
+}
+
+void BiasingOperator::OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                       G4BiasingAppliedCase biasingCase,
+                                       G4VBiasingOperation* occurenceOperationApplied,
+                                       G4double weightForOccurenceInteraction,
+                                       G4VBiasingOperation* finalStateOperationApplied,
+                                       const G4VParticleChange* particleChangeProduced)
+{
+  if (fDetConstruction->GetBiasingMode() == DetectorConstruction::BiasingMode::ForceCollision) {
+    fForceCollision->ReportOperationApplied(callingProcess, biasingCase,
+      occurenceOperationApplied, weightForOccurenceInteraction,
+      finalStateOperationApplied, particleChangeProduced);
+    return;
+  }
+  auto it = fImplicitCaptures.find(callingProcess);
+  if (it != fImplicitCaptures.end() && it->second == occurenceOperationApplied) {
+    it->second->SetInteractionOccured();
+  }
+}
+
+void BiasingOperator::ExitBiasing(const G4Track* track,
+                                  const G4BiasingProcessInterface* callingProcess)
+{
+  if (fDetConstruction->GetBiasingMode() == DetectorConstruction::BiasingMode::ForceCollision) {
+    fForceCollision->ExitingBiasing(track, callingProcess);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
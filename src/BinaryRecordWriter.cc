@@ -0,0 +1,218 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/BinaryRecordWriter.cc
+/// \brief Implementation of the GdNCap::BinaryRecordWriter class
+
+#include "BinaryRecordWriter.hh"
+#include "CaptureRecordFormat.hh"
+#include "ParticleTypeTable.hh"
+
+#include <cstring>
+
+#ifdef GDNCAP_USE_ZLIB
+#include "zlib.h"
+#endif
+
+namespace
+{
+  template <typename T>
+  char* AppendColumn(char* out, const std::vector<T>& column)
+  {
+    std::size_t size = column.size() * sizeof(T);
+    if (size > 0) std::memcpy(out, column.data(), size);
+    return out + size;
+  }
+
+  template <typename T>
+  void WriteValue(std::ofstream& file, const T& value)
+  {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+BinaryRecordWriter::BinaryRecordWriter(G4int compressionLevel)
+: fCompressionLevel(compressionLevel)
+{
+#ifndef GDNCAP_USE_ZLIB
+  if (fCompressionLevel > 0) {
+    G4ExceptionDescription msg;
+    msg << "Built without zlib, binary capture records are written uncompressed.";
+    G4Exception("BinaryRecordWriter::BinaryRecordWriter()", "MyCode0006",
+      JustWarning, msg);
+    fCompressionLevel = 0;
+  }
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+BinaryRecordWriter::~BinaryRecordWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String BinaryRecordWriter::GetFileName(const G4String& suffix)
+{
+  return "CaptureRecords" + suffix + ".gdnc";
+}
+
+std::vector<G4String> BinaryRecordWriter::GetFileNames(const G4String& suffix) const
+{
+  return { GetFileName(suffix) };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void BinaryRecordWriter::Open(const G4String& suffix)
+{
+  Close();
+  fFile.open(GetFileName(suffix), std::ios_base::out | std::ios_base::binary);
+  fNofEvents = 0;
+  fNofSecondaries = 0;
+  fNofBlocks = 0;
+
+  RecordFormat::FileHeader header = {};
+  std::memcpy(header.fMagic, RecordFormat::kFileMagic, sizeof(header.fMagic));
+  header.fVersion = RecordFormat::kVersion;
+  header.fPrimaryNameLength = static_cast<std::uint32_t>(fPrimaryName.size());
+  header.fPrimaryEnergy = fPrimaryEnergy;
+  WriteValue(fFile, header);
+  fFile.write(fPrimaryName.data(), fPrimaryName.size());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void BinaryRecordWriter::Write(const CaptureRecordView::Event& event)
+{
+  fEventId.push_back(event.GetEventId());
+  fEdep.push_back(event.GetEdep());
+  fTotalEnergy.push_back(event.GetTotalEnergy());
+  fMultiplicity.push_back(static_cast<std::uint32_t>(event.GetNumberOfSecondaries()));
+  for (std::size_t i = 0; i < event.GetNumberOfSecondaries(); ++i) {
+    fEnergy.push_back(event.GetEnergy(i));
+    fType.push_back(event.GetType(i));
+    fWeight.push_back(event.GetWeight(i));
+  }
+  ++fNofEvents;
+  fNofSecondaries += event.GetNumberOfSecondaries();
+
+  if (fEventId.size() == kEventsPerBlock) WriteBlock();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void BinaryRecordWriter::WriteBlock()
+{
+  if (fEventId.empty()) return;
+
+  RecordFormat::BlockHeader header = {};
+  std::memcpy(header.fMagic, RecordFormat::kBlockMagic, sizeof(header.fMagic));
+  header.fNofEvents = static_cast<std::uint32_t>(fEventId.size());
+  header.fNofSecondaries = static_cast<std::uint32_t>(fEnergy.size());
+  header.fRawSize = RecordFormat::GetRawSize(fEventId.size(), fEnergy.size());
+
+  fRaw.resize(header.fRawSize);
+  char* out = fRaw.data();
+  out = AppendColumn(out, fEventId);
+  out = AppendColumn(out, fEdep);
+  out = AppendColumn(out, fTotalEnergy);
+  out = AppendColumn(out, fMultiplicity);
+  out = AppendColumn(out, fEnergy);
+  out = AppendColumn(out, fType);
+  AppendColumn(out, fWeight);
+
+  const char* payload = fRaw.data();
+  header.fCompression = RecordFormat::kNone;
+  header.fStoredSize = header.fRawSize;
+#ifdef GDNCAP_USE_ZLIB
+  if (fCompressionLevel > 0) {
+    uLongf storedSize = compressBound(header.fRawSize);
+    fCompressed.resize(storedSize);
+    int status = compress2(reinterpret_cast<Bytef*>(fCompressed.data()), &storedSize,
+                           reinterpret_cast<const Bytef*>(fRaw.data()), header.fRawSize,
+                           fCompressionLevel);
+    // Keep the raw block if compression fails or does not pay off
+    if (status == Z_OK && storedSize < header.fRawSize) {
+      header.fCompression = RecordFormat::kZlib;
+      header.fStoredSize = storedSize;
+      payload = fCompressed.data();
+    }
+  }
+#endif
+
+  WriteValue(fFile, header);
+  fFile.write(payload, header.fStoredSize);
+  ++fNofBlocks;
+
+  fEventId.clear();
+  fEdep.clear();
+  fTotalEnergy.clear();
+  fMultiplicity.clear();
+  fEnergy.clear();
+  fType.clear();
+  fWeight.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void BinaryRecordWriter::Close()
+{
+  if (!IsOpen()) return;
+
+  WriteBlock();
+
+  // The type table is written last so that it holds every interned type
+  RecordFormat::Footer footer = {};
+  footer.fTypeTableOffset = static_cast<std::uint64_t>(fFile.tellp());
+  const auto typeTable = ParticleTypeTable::Instance();
+  const auto nofTypes = static_cast<std::uint32_t>(typeTable->GetNumberOfTypes());
+  WriteValue(fFile, nofTypes);
+  for (std::uint32_t id = 0; id < nofTypes; ++id) {
+    const G4String& name = typeTable->GetName(static_cast<ParticleTypeTable::TypeId>(id));
+    WriteValue(fFile, static_cast<std::uint32_t>(name.size()));
+    fFile.write(name.data(), name.size());
+  }
+
+  std::memcpy(footer.fMagic, RecordFormat::kFooterMagic, sizeof(footer.fMagic));
+  footer.fNofEvents = fNofEvents;
+  footer.fNofSecondaries = fNofSecondaries;
+  footer.fNofBlocks = fNofBlocks;
+  WriteValue(fFile, footer);
+
+  fFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,107 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/CaptureFilter.cc
+/// \brief Implementation of the GdNCap::CaptureFilter class
+
+#include "CaptureFilter.hh"
+#include "CaptureFilterMessenger.hh"
+
+#include "G4ParticleTable.hh"
+#include "G4ProcessTable.hh"
+#include "G4ProcessVector.hh"
+
+#include <algorithm>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureFilter::CaptureFilter()
+{
+  fMessenger = new CaptureFilterMessenger(this);
+}
+
+CaptureFilter::~CaptureFilter()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureFilter::Resolve()
+{
+  // With the biasing physics the processes are replaced by wrappers,
+  // which then define the steps and create the secondaries
+  fProcesses.clear();
+  for (const auto& name : fProcessNames) {
+    std::size_t nofFound = 0;
+    for (const G4String& processName : { name, G4String("biasWrapper(" + name + ")") }) {
+      G4ProcessVector* processes = G4ProcessTable::GetProcessTable()->FindProcesses(processName);
+      for (std::size_t i = 0; i < processes->size(); ++i) {
+        fProcesses.push_back((*processes)[i]);
+      }
+      nofFound += processes->size();
+      delete processes;
+    }
+    if (nofFound == 0) {
+      G4ExceptionDescription msg;
+      msg << "No process " << name << " in the physics list, "
+          << "its secondaries are not recorded.";
+      G4Exception("CaptureFilter::Resolve()", "MyCode0009", JustWarning, msg);
+    }
+  }
+
+  fParticles.clear();
+  auto particleTable = G4ParticleTable::GetParticleTable();
+  for (const auto& name : fParticleNames) {
+    const G4ParticleDefinition* particle = particleTable->FindParticle(name);
+    if (!particle) {
+      G4ExceptionDescription msg;
+      msg << "Unknown particle " << name << ", it is not recorded.";
+      G4Exception("CaptureFilter::Resolve()", "MyCode0009", JustWarning, msg);
+      continue;
+    }
+    fParticles.emplace_back(particle, ParticleTypeTable::Instance()->Intern(name));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CaptureFilter::IsCaptureProcessName(const G4String& name) const
+{
+  return std::find(fProcessNames.begin(), fProcessNames.end(), name) != fProcessNames.end();
+}
+
+G4bool CaptureFilter::IsRecordedParticleName(const G4String& name) const
+{
+  return std::find(fParticleNames.begin(), fParticleNames.end(), name) != fParticleNames.end();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
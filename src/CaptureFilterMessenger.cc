@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/CaptureFilterMessenger.cc
+/// \brief Implementation of the GdNCap::CaptureFilterMessenger class
+
+#include "CaptureFilterMessenger.hh"
+#include "CaptureFilter.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+
+#include <sstream>
+
+namespace
+{
+  std::vector<G4String> SplitNames(const G4String& value)
+  {
+    std::vector<G4String> names;
+    std::istringstream is(value);
+    G4String name;
+    while (is >> name) names.push_back(name);
+    return names;
+  }
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureFilterMessenger::CaptureFilterMessenger(CaptureFilter* filter)
+: fFilter(filter)
+{
+  fDirectory = new G4UIdirectory("/GdNCap/capture/");
+  fDirectory->SetGuidance("Selection of the recorded capture secondaries");
+
+  fProcessesCmd = new G4UIcmdWithAString("/GdNCap/capture/processes", this);
+  fProcessesCmd->SetGuidance("Names of the processes whose secondaries are recorded,");
+  fProcessesCmd->SetGuidance("separated by spaces (default: nCapture).");
+  fProcessesCmd->SetParameterName("names", false);
+  fProcessesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fParticlesCmd = new G4UIcmdWithAString("/GdNCap/capture/particles", this);
+  fParticlesCmd->SetGuidance("Names of the recorded secondary particles,");
+  fParticlesCmd->SetGuidance("separated by spaces (default: gamma e-).");
+  fParticlesCmd->SetParameterName("names", false);
+  fParticlesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fStringMatchCmd = new G4UIcmdWithABool("/GdNCap/capture/stringMatch", this);
+  fStringMatchCmd->SetGuidance("Compare process and particle names on every step, as the");
+  fStringMatchCmd->SetGuidance("original stepping action did, instead of the pointers");
+  fStringMatchCmd->SetGuidance("resolved at the start of run. For benchmarking only.");
+  fStringMatchCmd->SetParameterName("stringMatch", true);
+  fStringMatchCmd->SetDefaultValue(true);
+  fStringMatchCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fTransportCmd = new G4UIcmdWithAString("/GdNCap/capture/transport", this);
+  fTransportCmd->SetGuidance("Transport of the secondaries, once the capture products are recorded:");
+  fTransportCmd->SetGuidance("  full            - transport everything (default)");
+  fTransportCmd->SetGuidance("  killSecondaries - kill all secondaries but the neutrons");
+  fTransportCmd->SetGuidance("  captureGammas   - track only the neutrons and the gammas created");
+  fTransportCmd->SetGuidance("                    by the capture");
+  fTransportCmd->SetGuidance("Except in full mode the energy deposit is not scored.");
+  fTransportCmd->SetParameterName("transport", false);
+  fTransportCmd->SetCandidates("full killSecondaries captureGammas");
+  fTransportCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureFilterMessenger::~CaptureFilterMessenger()
+{
+  delete fTransportCmd;
+  delete fStringMatchCmd;
+  delete fParticlesCmd;
+  delete fProcessesCmd;
+  delete fDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureFilterMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fProcessesCmd) {
+    fFilter->SetProcessNames(SplitNames(newValue));
+  }
+  else if (command == fParticlesCmd) {
+    fFilter->SetParticleNames(SplitNames(newValue));
+  }
+  else if (command == fStringMatchCmd) {
+    fFilter->SetStringMatch(fStringMatchCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fTransportCmd) {
+    using Transport = CaptureFilter::Transport;
+    if (newValue == "killSecondaries") fFilter->SetTransport(Transport::KillSecondaries);
+    else if (newValue == "captureGammas") fFilter->SetTransport(Transport::CaptureGammas);
+    else fFilter->SetTransport(Transport::Full);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,123 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/CaptureRecordBlock.cc
+/// \brief Implementation of the GdNCap::CaptureRecordBlock class
+
+#include "CaptureRecordBlock.hh"
+
+#include <algorithm>
+#include <numeric>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureRecordBlock::CaptureRecordBlock(std::size_t capacity)
+: fCapacity(capacity)
+{
+  fEventId.reserve(capacity);
+  fEdep.reserve(capacity);
+  fTotalEnergy.reserve(capacity);
+  fOffset.reserve(capacity + 1);
+  fOffset.push_back(0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureRecordBlock::AddEvent(G4int eventId, G4double edep,
+                                  G4double totalEnergy,
+                                  const std::vector<G4double>& energies,
+                                  const std::vector<TypeId>& types,
+                                  const std::vector<G4double>& weights)
+{
+  if (!fEventId.empty() && eventId <= fEventId.back()) fSorted = false;
+  fEventId.push_back(eventId);
+  fEdep.push_back(edep);
+  fTotalEnergy.push_back(totalEnergy);
+  fEnergy.insert(fEnergy.end(), energies.begin(), energies.end());
+  fType.insert(fType.end(), types.begin(), types.end());
+  fWeight.insert(fWeight.end(), weights.begin(), weights.end());
+  fOffset.push_back(static_cast<std::uint32_t>(fEnergy.size()));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureRecordBlock CaptureRecordBlock::SortedByEventId() const
+{
+  std::vector<std::size_t> order(GetNumberOfEvents());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+    [this](std::size_t a, std::size_t b) { return fEventId[a] < fEventId[b]; });
+
+  CaptureRecordBlock sorted(fCapacity);
+  std::vector<G4double> energies;
+  std::vector<TypeId> types;
+  std::vector<G4double> weights;
+  for (auto row : order) {
+    auto first = fEnergy.begin() + fOffset[row];
+    auto last = fEnergy.begin() + fOffset[row + 1];
+    energies.assign(first, last);
+    types.assign(fType.begin() + fOffset[row], fType.begin() + fOffset[row + 1]);
+    weights.assign(fWeight.begin() + fOffset[row], fWeight.begin() + fOffset[row + 1]);
+    sorted.AddEvent(fEventId[row], fEdep[row], fTotalEnergy[row], energies, types, weights);
+  }
+  return sorted;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t CaptureRecordBlock::GetMemoryUsage() const
+{
+  return sizeof(CaptureRecordBlock)
+    + fEventId.capacity() * sizeof(G4int)
+    + fEdep.capacity() * sizeof(G4double)
+    + fTotalEnergy.capacity() * sizeof(G4double)
+    + fOffset.capacity() * sizeof(std::uint32_t)
+    + fEnergy.capacity() * sizeof(G4double)
+    + fType.capacity() * sizeof(TypeId)
+    + fWeight.capacity() * sizeof(G4double);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureRecordBlock::Clear()
+{
+  // Keeps the allocated capacity so the block can be refilled
+  fSorted = true;
+  fEventId.clear();
+  fEdep.clear();
+  fTotalEnergy.clear();
+  fOffset.resize(1);
+  fEnergy.clear();
+  fType.clear();
+  fWeight.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,119 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/CaptureRecordView.cc
+/// \brief Implementation of the GdNCap::CaptureRecordView class
+
+#include "CaptureRecordView.hh"
+
+#include <algorithm>
+
+namespace
+{
+  // Min-heap on the event ID; the sequence index only breaks ties so that
+  // the order stays reproducible even with duplicated IDs
+  struct Later
+  {
+    template <typename P>
+    bool operator()(const P& a, const P& b) const
+    {
+      if (a.fEventId != b.fEventId) return a.fEventId > b.fEventId;
+      return a.fSequence > b.fSequence;
+    }
+  };
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t CaptureRecordView::GetNumberOfEvents() const
+{
+  std::size_t nofEvents = 0;
+  for (const auto& sequence : fSequences) {
+    for (auto block : sequence) nofEvents += block->GetNumberOfEvents();
+  }
+  return nofEvents;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t CaptureRecordView::GetNumberOfSecondaries() const
+{
+  std::size_t nofSecondaries = 0;
+  for (const auto& sequence : fSequences) {
+    for (auto block : sequence) nofSecondaries += block->GetNumberOfSecondaries();
+  }
+  return nofSecondaries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureRecordView::Cursor::Cursor(const CaptureRecordView& view)
+: fView(view)
+{
+  fHeap.reserve(view.fSequences.size());
+  for (std::size_t sequence = 0; sequence < view.fSequences.size(); ++sequence) {
+    Push(sequence, 0, 0);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureRecordView::Cursor::Push(std::size_t sequence, std::size_t block,
+                                     std::size_t row)
+{
+  const auto& blocks = fView.fSequences[sequence];
+  // Skip to the next non-empty block of the sequence
+  while (block < blocks.size() && row >= blocks[block]->GetNumberOfEvents()) {
+    ++block;
+    row = 0;
+  }
+  if (block == blocks.size()) return;
+
+  fHeap.push_back({blocks[block]->GetEventId(row), sequence, block, row});
+  std::push_heap(fHeap.begin(), fHeap.end(), Later());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CaptureRecordView::Cursor::Next(Event& event)
+{
+  if (fHeap.empty()) return false;
+
+  std::pop_heap(fHeap.begin(), fHeap.end(), Later());
+  Position position = fHeap.back();
+  fHeap.pop_back();
+
+  event = Event(fView.fSequences[position.fSequence][position.fBlock], position.fRow);
+  Push(position.fSequence, position.fBlock, position.fRow + 1);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/CascadeGenerator.cc
+/// \brief Implementation of the GdNCap::CascadeGenerator class
+
+#include "CascadeGenerator.hh"
+#include "CascadeLibrary.hh"
+
+#include "G4Event.hh"
+#include "G4Gamma.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4RandomDirection.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CascadeGenerator::CascadeGenerator()
+: fGamma(G4Gamma::Definition())
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CascadeGenerator::GeneratePrimaryVertex(G4Event* event)
+{
+  if (!fLibrary) return;
+
+  G4double u1 = G4UniformRand();
+  G4double u2 = G4UniformRand();
+  const CascadeLibrary::Cascade cascade = fLibrary->Sample(u1, u2);
+
+  auto vertex = new G4PrimaryVertex(particle_position, particle_time);
+  for (std::size_t i = 0; i < cascade.fNofGammas; ++i) {
+    auto gamma = new G4PrimaryParticle(fGamma);
+    gamma->SetKineticEnergy(cascade.fEnergies[i] * MeV);
+    gamma->SetMomentumDirection(G4RandomDirection());
+    vertex->SetPrimary(gamma);
+  }
+  event->AddPrimaryVertex(vertex);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
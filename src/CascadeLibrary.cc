@@ -0,0 +1,259 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/CascadeLibrary.cc
+/// \brief Implementation of the GdNCap::CascadeLibrary class
+
+#include "CascadeLibrary.hh"
+#include "CascadeLibraryFormat.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+  template <typename T>
+  void WriteValue(std::ofstream& file, const T& value)
+  {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  void WriteColumn(std::ofstream& file, const std::vector<T>& column)
+  {
+    file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+  }
+
+  template <typename T>
+  G4bool ReadColumn(std::ifstream& file, std::vector<T>& column, std::size_t size)
+  {
+    column.resize(size);
+    file.read(reinterpret_cast<char*>(column.data()), size * sizeof(T));
+    return bool(file);
+  }
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CascadeLibrary::Isotope& CascadeLibrary::FindOrAdd(G4int Z, G4int A)
+{
+  // A handful of isotopes, a linear search is fine
+  for (auto& isotope : fIsotopes) {
+    if (isotope.fZ == Z && isotope.fA == A) return isotope;
+  }
+  fIsotopes.emplace_back();
+  fIsotopes.back().fZ = Z;
+  fIsotopes.back().fA = A;
+  return fIsotopes.back();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CascadeLibrary::AddCascade(G4int Z, G4int A, const std::vector<G4double>& energies)
+{
+  Isotope& isotope = FindOrAdd(Z, A);
+  ++isotope.fNofCaptures;
+  if (fMaxCascades > 0 && G4long(isotope.GetNumberOfCascades()) >= fMaxCascades) return;
+  isotope.fEnergies.insert(isotope.fEnergies.end(), energies.begin(), energies.end());
+  isotope.fFirst.push_back(static_cast<std::uint32_t>(isotope.fEnergies.size()));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CascadeLibrary::Merge(const G4VAccumulable& other)
+{
+  const auto& otherLibrary = static_cast<const CascadeLibrary&>(other);
+  for (const auto& otherIsotope : otherLibrary.fIsotopes) {
+    Isotope& isotope = FindOrAdd(otherIsotope.fZ, otherIsotope.fA);
+    isotope.fNofCaptures += otherIsotope.fNofCaptures;
+
+    std::size_t nofCascades = otherIsotope.GetNumberOfCascades();
+    if (fMaxCascades > 0) {
+      G4long room = std::max<G4long>(fMaxCascades - G4long(isotope.GetNumberOfCascades()), 0);
+      nofCascades = std::min<std::size_t>(nofCascades, room);
+    }
+    const std::uint32_t base = static_cast<std::uint32_t>(isotope.fEnergies.size());
+    isotope.fEnergies.insert(isotope.fEnergies.end(), otherIsotope.fEnergies.begin(),
+                             otherIsotope.fEnergies.begin() + otherIsotope.fFirst[nofCascades]);
+    for (std::size_t i = 1; i <= nofCascades; ++i) {
+      isotope.fFirst.push_back(base + otherIsotope.fFirst[i]);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CascadeLibrary::Reset()
+{
+  fIsotopes.clear();
+  fSelection.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t CascadeLibrary::GetMemoryUsage() const
+{
+  std::size_t bytes = sizeof(CascadeLibrary) + fIsotopes.capacity() * sizeof(Isotope)
+    + fSelection.capacity() * sizeof(fSelection[0]);
+  for (const auto& isotope : fIsotopes) {
+    bytes += isotope.fFirst.capacity() * sizeof(std::uint32_t)
+      + isotope.fEnergies.capacity() * sizeof(float);
+  }
+  return bytes;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CascadeLibrary::Write(const G4String& fileName) const
+{
+  std::ofstream file(fileName, std::ios_base::out | std::ios_base::binary);
+  if (!file) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open " << fileName << " for writing.";
+    G4Exception("CascadeLibrary::Write()", "MyCode0010", JustWarning, msg);
+    return false;
+  }
+
+  CascadeFormat::FileHeader header = {};
+  std::memcpy(header.fMagic, CascadeFormat::kFileMagic, sizeof(header.fMagic));
+  header.fVersion = CascadeFormat::kVersion;
+  header.fNofIsotopes = static_cast<std::uint32_t>(fIsotopes.size());
+  WriteValue(file, header);
+
+  std::uint64_t offset = sizeof(header) + fIsotopes.size() * sizeof(CascadeFormat::IsotopeEntry);
+  for (const auto& isotope : fIsotopes) {
+    CascadeFormat::IsotopeEntry entry = {};
+    entry.fZ = isotope.fZ;
+    entry.fA = isotope.fA;
+    entry.fNofCaptures = isotope.fNofCaptures;
+    entry.fNofCascades = isotope.GetNumberOfCascades();
+    entry.fNofGammas = isotope.fEnergies.size();
+    entry.fOffset = offset;
+    WriteValue(file, entry);
+    offset += isotope.fFirst.size() * sizeof(std::uint32_t)
+            + isotope.fEnergies.size() * sizeof(float);
+  }
+  for (const auto& isotope : fIsotopes) {
+    WriteColumn(file, isotope.fFirst);
+    WriteColumn(file, isotope.fEnergies);
+  }
+  return bool(file);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CascadeLibrary::Read(const G4String& fileName)
+{
+  Reset();
+
+  G4ExceptionDescription msg;
+  std::ifstream file(fileName, std::ios_base::in | std::ios_base::binary);
+  CascadeFormat::FileHeader header = {};
+  std::vector<CascadeFormat::IsotopeEntry> entries;
+  if (!file) {
+    msg << "Cannot open " << fileName << ".";
+  }
+  else if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+           || std::memcmp(header.fMagic, CascadeFormat::kFileMagic, sizeof(header.fMagic)) != 0
+           || header.fVersion != CascadeFormat::kVersion) {
+    msg << fileName << " is not a cascade library of version " << CascadeFormat::kVersion << ".";
+  }
+  else if (!ReadColumn(file, entries, header.fNofIsotopes)) {
+    msg << fileName << " is truncated.";
+  }
+
+  for (const auto& entry : entries) {
+    if (!msg.str().empty()) break;
+    Isotope isotope;
+    isotope.fZ = entry.fZ;
+    isotope.fA = entry.fA;
+    isotope.fNofCaptures = entry.fNofCaptures;
+    file.seekg(entry.fOffset);
+    if (!ReadColumn(file, isotope.fFirst, entry.fNofCascades + 1)
+        || !ReadColumn(file, isotope.fEnergies, entry.fNofGammas)) {
+      msg << fileName << " is truncated.";
+    }
+    else if (isotope.fFirst.back() != entry.fNofGammas) {
+      msg << fileName << " has an inconsistent cascade index for Z = "
+          << entry.fZ << ", A = " << entry.fA << ".";
+    }
+    else {
+      fIsotopes.push_back(std::move(isotope));
+    }
+  }
+
+  if (!msg.str().empty()) {
+    G4Exception("CascadeLibrary::Read()", "MyCode0010", JustWarning, msg);
+    Reset();
+    return false;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CascadeLibrary::Select(G4int Z, G4int A)
+{
+  fSelection.clear();
+  G4double total = 0.;
+  for (const auto& isotope : fIsotopes) {
+    if (isotope.GetNumberOfCascades() == 0) continue;
+    if (Z > 0 && (isotope.fZ != Z || isotope.fA != A)) continue;
+    total += isotope.fNofCaptures;
+    fSelection.emplace_back(&isotope, total);
+  }
+  for (auto& selected : fSelection) selected.second /= total;
+  return !fSelection.empty();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CascadeLibrary::Cascade CascadeLibrary::Sample(G4double u1, G4double u2) const
+{
+  Cascade cascade;
+  if (fSelection.empty()) return cascade;
+
+  const Isotope* isotope = fSelection.back().first;
+  for (const auto& [selected, fraction] : fSelection) {
+    if (u1 < fraction) {
+      isotope = selected;
+      break;
+    }
+  }
+  std::size_t nofCascades = isotope->GetNumberOfCascades();
+  std::size_t i = std::min(static_cast<std::size_t>(u2 * nofCascades), nofCascades - 1);
+  cascade.fEnergies = isotope->fEnergies.data() + isotope->fFirst[i];
+  cascade.fNofGammas = isotope->fFirst[i + 1] - isotope->fFirst[i];
+  return cascade;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,115 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/ChildProcess.cc
+/// \brief Implementation of the GdNCap::ChildProcess class
+
+#include "ChildProcess.hh"
+
+#include <cstdlib>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define GDNCAP_HAVE_FORK 1
+#endif
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ChildProcess::ChildProcess(const G4String& program)
+: fProgram(program.find('/') == std::string::npos ? program : GetAbsolutePath(program))
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String ChildProcess::GetAbsolutePath(const G4String& path)
+{
+#ifdef GDNCAP_HAVE_FORK
+  char* resolved = realpath(path.c_str(), nullptr);
+  if (!resolved) return path;
+  G4String absolutePath = resolved;
+  std::free(resolved);
+  return absolutePath;
+#else
+  return path;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ChildProcess::Run(const std::vector<G4String>& arguments, const G4String& directory)
+{
+  fPeakMemory = 0.;
+#ifdef GDNCAP_HAVE_FORK
+  mkdir(directory.c_str(), 0755);
+
+  std::vector<std::string> strings = { fProgram };
+  strings.insert(strings.end(), arguments.begin(), arguments.end());
+  std::vector<char*> argv;
+  for (auto& argument : strings) argv.push_back(argument.data());
+  argv.push_back(nullptr);
+
+  const pid_t pid = fork();
+  if (pid == 0) {
+    // Child: its output goes to the log of its directory
+    if (chdir(directory.c_str()) != 0) _exit(127);
+    int log = open("log.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (log >= 0) {
+      dup2(log, STDOUT_FILENO);
+      dup2(log, STDERR_FILENO);
+      close(log);
+    }
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+  if (pid < 0) return false;
+
+  int status = 0;
+  struct rusage usage = {};
+  if (wait4(pid, &status, 0, &usage) < 0) return false;
+#ifdef __APPLE__
+  fPeakMemory = usage.ru_maxrss / (1024. * 1024.);
+#else
+  fPeakMemory = usage.ru_maxrss / 1024.;
+#endif
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#else
+  G4Exception("ChildProcess::Run()", "MyCode0011", JustWarning,
+    "Child processes are not available here.");
+  return false;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -28,9 +28,17 @@
 /// \brief Implementation of the GdNCap::DetectorConstruction class
 
 #include "DetectorConstruction.hh"
+#include "DetectorMessenger.hh"
+#include "EnvelopeSD.hh"
+#include "BiasingOperator.hh"
+#include "StartupMonitor.hh"
 
 #include "G4RunManager.hh"
 #include "G4NistManager.hh"
+#include "G4GeometryManager.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4SolidStore.hh"
 #include "G4Box.hh"
 #include "G4Cons.hh"
 #include "G4Orb.hh"
@@ -39,18 +47,46 @@
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4SDManager.hh"
+#include "G4StateManager.hh"
+#include "G4Threading.hh"
+#include "G4Timer.hh"
 
 #include "G4Isotope.hh"
 
 #include "G4VisAttributes.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+
+namespace
+{
+  // Each thread's operator, kept across geometry rebuilds
+  G4ThreadLocal GdNCap::BiasingOperator* biasingOperator = nullptr;
+}
 
 namespace GdNCap
 {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-G4VPhysicalVolume* DetectorConstruction::Construct()
+DetectorConstruction::DetectorConstruction()
+: fSplitLength(1. * mm), fEnvSizeXY(5. * cm), fEnvSizeZ(1. * cm)
 {
+  fMessenger = new DetectorMessenger(this);
+}
+
+DetectorConstruction::~DetectorConstruction()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::DefineMaterials()
+{
+  if (fMaterialsDefined) return;
+  fMaterialsDefined = true;
+
   // Get nist material manager
   G4NistManager* nist = G4NistManager::Instance();
 
@@ -79,15 +115,54 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   myC12->AddElement(elC12, 100. * perCent);
 
   G4Material* natC = nist->FindOrBuildMaterial("G4_C");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool DetectorConstruction::AddMaterial(const G4String& name)
+{
+  DefineMaterials();
+  if (G4Material::GetMaterial(name, false)) return true;
+
+  if (!G4NistManager::Instance()->FindOrBuildMaterial(name)) {
+    G4ExceptionDescription msg;
+    msg << "Unknown material " << name << ".";
+    G4Exception("DetectorConstruction::AddMaterial()", "MyCode0011", JustWarning, msg);
+    return false;
+  }
+  // The physics tables, and the HP data, only know the materials of the
+  // initialization
+  if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle) {
+    G4RunManager::GetRunManager()->PhysicsHasBeenModified();
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VPhysicalVolume* DetectorConstruction::Construct()
+{
+  G4Timer timer;
+  timer.Start();
+
+  // Rebuilt by /run/reinitializeGeometry: clean the old geometry
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  G4PhysicalVolumeStore::GetInstance()->Clean();
+  G4LogicalVolumeStore::GetInstance()->Clean();
+  G4SolidStore::GetInstance()->Clean();
 
-  // Envelope parameters
+  DefineMaterials();
+  G4NistManager* nist = G4NistManager::Instance();
+
+  // Envelope parameters (/GdNCap/detector/)
   //
-  G4double env_sizeXY = 5. * cm, env_sizeZ = 1. * cm;
-  G4Material* env_mat = nist->FindOrBuildMaterial("myGd157");
+  G4double env_sizeXY = fEnvSizeXY, env_sizeZ = fEnvSizeZ;
+  G4Material* env_mat = nist->FindOrBuildMaterial(fEnvMaterial);
 
   // Option to switch on/off checking of volumes overlaps
+  // (/GdNCap/detector/checkOverlaps)
   //
-  G4bool checkOverlaps = true;
+  G4bool checkOverlaps = fCheckOverlaps;
 
   //
   // World
@@ -138,7 +213,12 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   //
   fScoringVolume = logicEnv;
 
-  G4cout << *(G4Material::GetMaterialTable()) << G4endl;
+  if (fPrintMaterials) G4cout << *(G4Material::GetMaterialTable()) << G4endl;
+
+  timer.Stop();
+  if (auto monitor = StartupMonitor::Instance()) {
+    monitor->AddPhase("geometry", timer.GetRealElapsed());
+  }
   //
   //always return the physical World
   //
@@ -147,4 +227,114 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void DetectorConstruction::ConstructSDandField()
+{
+  if (fScoringMode == ScoringMode::SensitiveDetector) {
+    // Only the scoring volume is sensitive, steps elsewhere are not seen;
+    // a rebuilt geometry reuses the thread's detector
+    G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+    G4VSensitiveDetector* envelopeSD = sdManager->FindSensitiveDetector("GdNCap/EnvelopeSD", false);
+    if (!envelopeSD) {
+      envelopeSD = new EnvelopeSD("GdNCap/EnvelopeSD");
+      sdManager->AddNewDetector(envelopeSD);
+    }
+    SetSensitiveDetector(fScoringVolume, envelopeSD);
+  }
+
+  // One operator per thread; it does nothing while the mode is "none"
+  if (fBiasing) {
+    if (!biasingOperator) biasingOperator = new BiasingOperator(this);
+    biasingOperator->AttachTo(fScoringVolume);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetBiasingMode(BiasingMode mode)
+{
+  if (mode != BiasingMode::None && !fBiasing) {
+    G4ExceptionDescription msg;
+    msg << "The physics list has no biasing, start the application with -b;"
+        << " the run is not biased.";
+    G4Exception("DetectorConstruction::SetBiasingMode()", "MyCode0011",
+      JustWarning, msg);
+    return;
+  }
+  fBiasingMode = mode;
+}
+
+void DetectorConstruction::SetRouletteWeights(G4double threshold, G4double survival)
+{
+  if (survival <= 0.) survival = 2. * threshold;
+  if (survival < threshold) {
+    G4ExceptionDescription msg;
+    msg << "The survival weight " << survival << " of the roulette is below its"
+        << " threshold " << threshold << "; the roulette is unchanged.";
+    G4Exception("DetectorConstruction::SetRouletteWeights()", "MyCode0011",
+      JustWarning, msg);
+    return;
+  }
+  fRouletteThreshold = threshold;
+  fRouletteSurvival = survival;
+}
+
+const BiasingOperator* DetectorConstruction::GetBiasingOperator() const
+{
+  return biasingOperator;
+}
+
+G4bool DetectorConstruction::SetEnvelopeSizeXY(G4double size)
+{
+  if (size == fEnvSizeXY) return false;
+  fEnvSizeXY = size;
+  return true;
+}
+
+G4bool DetectorConstruction::SetEnvelopeThickness(G4double thickness)
+{
+  if (thickness == fEnvSizeZ) return false;
+  fEnvSizeZ = thickness;
+  return true;
+}
+
+G4bool DetectorConstruction::SetEnvelopeMaterial(const G4String& name)
+{
+  if (name == fEnvMaterial || !AddMaterial(name)) return false;
+  fEnvMaterial = name;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String DetectorConstruction::GetBiasingModeName() const
+{
+  switch (fBiasingMode) {
+    case BiasingMode::ForceCollision: return "forceCollision";
+    case BiasingMode::ImplicitCapture: return "implicitCapture";
+    case BiasingMode::Splitting: return "splitting";
+    default: return "none";
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double DetectorConstruction::GetDepth(const G4VTouchable* touchable,
+                                        const G4ThreeVector& position) const
+{
+  G4ThreeVector pMin, pMax;
+  fScoringVolume->GetSolid()->BoundingLimits(pMin, pMax);
+  const G4ThreeVector localPosition =
+    touchable->GetHistory()->GetTopTransform().TransformPoint(position);
+  return localPosition.z() - pMin.z();
+}
+
+G4double DetectorConstruction::GetThickness() const
+{
+  G4ThreeVector pMin, pMax;
+  fScoringVolume->GetSolid()->BoundingLimits(pMin, pMax);
+  return pMax.z() - pMin.z();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 }
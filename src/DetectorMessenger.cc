@@ -0,0 +1,222 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/DetectorMessenger.cc
+/// \brief Implementation of the GdNCap::DetectorMessenger class
+
+#include "DetectorMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4StateManager.hh"
+#include "G4UImanager.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+#include <sstream>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorMessenger::DetectorMessenger(DetectorConstruction* detConstruction)
+: fDetConstruction(detConstruction)
+{
+  fBiasingDirectory = new G4UIdirectory("/GdNCap/biasing/", false);
+  fBiasingDirectory->SetGuidance("Variance reduction of the neutron transport in the envelope");
+  fBiasingDirectory->SetGuidance("(requires the biasing physics, option -b).");
+
+  fBiasingModeCmd = new G4UIcmdWithAString("/GdNCap/biasing/mode", this);
+  fBiasingModeCmd->SetGuidance("Biasing of the neutrons in the envelope:");
+  fBiasingModeCmd->SetGuidance("  none            - analog transport (default)");
+  fBiasingModeCmd->SetGuidance("  forceCollision  - force the first interaction of entering neutrons,");
+  fBiasingModeCmd->SetGuidance("                    the uncollided part is transported with its weight");
+  fBiasingModeCmd->SetGuidance("  implicitCapture - suppress the capture, the neutron weight is reduced");
+  fBiasingModeCmd->SetGuidance("                    by the capture probability along each step instead;");
+  fBiasingModeCmd->SetGuidance("                    no capture products are recorded; below the");
+  fBiasingModeCmd->SetGuidance("                    weight /GdNCap/biasing/roulette the neutron");
+  fBiasingModeCmd->SetGuidance("                    plays Russian roulette");
+  fBiasingModeCmd->SetGuidance("  splitting       - split neutrons in two at every depth cell");
+  fBiasingModeCmd->SetGuidance("                    (/GdNCap/biasing/splitLength) they reach first");
+  fBiasingModeCmd->SetParameterName("mode", false);
+  fBiasingModeCmd->SetCandidates("none forceCollision implicitCapture splitting");
+  fBiasingModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fBiasingModeCmd->SetToBeBroadcasted(false);
+
+  fSplitLengthCmd = new G4UIcmdWithADoubleAndUnit("/GdNCap/biasing/splitLength", this);
+  fSplitLengthCmd->SetGuidance("Depth of the splitting cells (default: 1 mm).");
+  fSplitLengthCmd->SetParameterName("length", false);
+  fSplitLengthCmd->SetUnitCategory("Length");
+  fSplitLengthCmd->SetRange("length > 0.");
+  fSplitLengthCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSplitLengthCmd->SetToBeBroadcasted(false);
+
+  fRouletteCmd = new G4UIcommand("/GdNCap/biasing/roulette", this);
+  fRouletteCmd->SetGuidance("Russian roulette of the implicit capture: a neutron whose weight w");
+  fRouletteCmd->SetGuidance("falls below the threshold is killed with the probability 1 - w/w_s,");
+  fRouletteCmd->SetGuidance("and otherwise continues with the survival weight w_s. Without it,");
+  fRouletteCmd->SetGuidance("neutrons only end by leaving the envelope, after random walks on");
+  fRouletteCmd->SetGuidance("vanishing weights. Threshold 0 disables it (default: 0.25 0.5).");
+  auto thresholdParam = new G4UIparameter("threshold", 'd', false);
+  thresholdParam->SetParameterRange("threshold >= 0.");
+  fRouletteCmd->SetParameter(thresholdParam);
+  auto survivalParam = new G4UIparameter("survival", 'd', true);
+  survivalParam->SetGuidance("Survival weight, 0 for twice the threshold.");
+  survivalParam->SetDefaultValue(0.);
+  fRouletteCmd->SetParameter(survivalParam);
+  fRouletteCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fRouletteCmd->SetToBeBroadcasted(false);
+
+  fDetectorDirectory = new G4UIdirectory("/GdNCap/detector/", false);
+  fDetectorDirectory->SetGuidance("Envelope of the detector, and diagnostics of its");
+  fDetectorDirectory->SetGuidance("construction to be set before /run/initialize.");
+
+  fCheckOverlapsCmd = new G4UIcmdWithABool("/GdNCap/detector/checkOverlaps", this);
+  fCheckOverlapsCmd->SetGuidance("Check the overlaps of the volumes at their placement");
+  fCheckOverlapsCmd->SetGuidance("(default: false; /geometry/test/run checks them later).");
+  fCheckOverlapsCmd->SetParameterName("check", true);
+  fCheckOverlapsCmd->SetDefaultValue(true);
+  fCheckOverlapsCmd->AvailableForStates(G4State_PreInit);
+  fCheckOverlapsCmd->SetToBeBroadcasted(false);
+
+  fPrintMaterialsCmd = new G4UIcmdWithABool("/GdNCap/detector/printMaterials", this);
+  fPrintMaterialsCmd->SetGuidance("Print the material table after the construction (default: false).");
+  fPrintMaterialsCmd->SetParameterName("print", true);
+  fPrintMaterialsCmd->SetDefaultValue(true);
+  fPrintMaterialsCmd->AvailableForStates(G4State_PreInit);
+  fPrintMaterialsCmd->SetToBeBroadcasted(false);
+
+  fSizeXYCmd = new G4UIcmdWithADoubleAndUnit("/GdNCap/detector/sizeXY", this);
+  fSizeXYCmd->SetGuidance("Transverse size of the envelope (default: 5 cm).");
+  fSizeXYCmd->SetParameterName("size", false);
+  fSizeXYCmd->SetUnitCategory("Length");
+  fSizeXYCmd->SetRange("size > 0.");
+  fSizeXYCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSizeXYCmd->SetToBeBroadcasted(false);
+
+  fThicknessCmd = new G4UIcmdWithADoubleAndUnit("/GdNCap/detector/thickness", this);
+  fThicknessCmd->SetGuidance("Thickness of the envelope along the beam (default: 1 cm).");
+  fThicknessCmd->SetParameterName("thickness", false);
+  fThicknessCmd->SetUnitCategory("Length");
+  fThicknessCmd->SetRange("thickness > 0.");
+  fThicknessCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fThicknessCmd->SetToBeBroadcasted(false);
+
+  fMaterialCmd = new G4UIcmdWithAString("/GdNCap/detector/material", this);
+  fMaterialCmd->SetGuidance("Material of the envelope: myGd155 or myGd157 (enriched,");
+  fMaterialCmd->SetGuidance("default myGd157), G4_Gd (natural) or any NIST material.");
+  fMaterialCmd->SetGuidance("A NIST material named after /run/initialize rebuilds the physics");
+  fMaterialCmd->SetGuidance("tables at the next run.");
+  fMaterialCmd->SetParameterName("material", false);
+  fMaterialCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fMaterialCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorMessenger::~DetectorMessenger()
+{
+  delete fMaterialCmd;
+  delete fThicknessCmd;
+  delete fSizeXYCmd;
+  delete fPrintMaterialsCmd;
+  delete fCheckOverlapsCmd;
+  delete fDetectorDirectory;
+  delete fRouletteCmd;
+  delete fSplitLengthCmd;
+  delete fBiasingModeCmd;
+  delete fBiasingDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fBiasingModeCmd) {
+    using BiasingMode = DetectorConstruction::BiasingMode;
+    if (newValue == "forceCollision") fDetConstruction->SetBiasingMode(BiasingMode::ForceCollision);
+    else if (newValue == "implicitCapture") fDetConstruction->SetBiasingMode(BiasingMode::ImplicitCapture);
+    else if (newValue == "splitting") fDetConstruction->SetBiasingMode(BiasingMode::Splitting);
+    else fDetConstruction->SetBiasingMode(BiasingMode::None);
+  }
+  else if (command == fRouletteCmd) {
+    std::istringstream is(newValue);
+    G4double threshold = 0., survival = 0.;
+    is >> threshold >> survival;
+    fDetConstruction->SetRouletteWeights(threshold, survival);
+  }
+  else if (command == fSplitLengthCmd) {
+    fDetConstruction->SetSplitLength(fSplitLengthCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fCheckOverlapsCmd) {
+    fDetConstruction->SetCheckOverlaps(fCheckOverlapsCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fPrintMaterialsCmd) {
+    fDetConstruction->SetPrintMaterials(fPrintMaterialsCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fSizeXYCmd) {
+    if (fDetConstruction->SetEnvelopeSizeXY(fSizeXYCmd->GetNewDoubleValue(newValue))) {
+      ReinitializeGeometry();
+    }
+  }
+  else if (command == fThicknessCmd) {
+    if (fDetConstruction->SetEnvelopeThickness(fThicknessCmd->GetNewDoubleValue(newValue))) {
+      ReinitializeGeometry();
+    }
+  }
+  else if (command == fMaterialCmd) {
+    if (fDetConstruction->SetEnvelopeMaterial(newValue)) ReinitializeGeometry();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String DetectorMessenger::GetCurrentValue(G4UIcommand* command)
+{
+  if (command == fSizeXYCmd) {
+    return fSizeXYCmd->ConvertToString(fDetConstruction->GetEnvelopeSizeXY(), "mm");
+  }
+  if (command == fThicknessCmd) {
+    return fThicknessCmd->ConvertToString(fDetConstruction->GetEnvelopeThickness(), "mm");
+  }
+  if (command == fMaterialCmd) return fDetConstruction->GetEnvelopeMaterial();
+  return "";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorMessenger::ReinitializeGeometry()
+{
+  // Before the initialization the geometry is built with the new values
+  if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle) return;
+  G4UImanager::GetUIpointer()->ApplyCommand("/run/reinitializeGeometry");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
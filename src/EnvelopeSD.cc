@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/EnvelopeSD.cc
+/// \brief Implementation of the GdNCap::EnvelopeSD class
+
+#include "EnvelopeSD.hh"
+#include "EventAction.hh"
+
+#include "G4EventManager.hh"
+#include "G4Step.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EnvelopeSD::EnvelopeSD(const G4String& name)
+: G4VSensitiveDetector(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnvelopeSD::Initialize(G4HCofThisEvent*)
+{
+  // The event action of this thread exists once the first event starts
+  if (!fEventAction) {
+    fEventAction = static_cast<EventAction*>(
+      G4EventManager::GetEventManager()->GetUserEventAction());
+  }
+  fEdep = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool EnvelopeSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  fEdep += step->GetTotalEnergyDeposit() * step->GetPreStepPoint()->GetWeight();
+  fEventAction->ScoreNeutronStep(step);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnvelopeSD::EndOfEvent(G4HCofThisEvent*)
+{
+  // Called before the EndOfEventAction of the user event action
+  fEventAction->AddEdep(fEdep);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
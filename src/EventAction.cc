@@ -29,9 +29,25 @@
 
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "BiasingOperator.hh"
+#include "CascadeLibrary.hh"
+#include "DetectorConstruction.hh"
+#include "MemoryMonitor.hh"
+#include "RouletteOperation.hh"
+#include "StartupMonitor.hh"
+#include "WorkerTelemetry.hh"
 
+#include "G4AnalysisManager.hh"
+#include "G4BiasingProcessInterface.hh"
 #include "G4Event.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4HadronicProcess.hh"
+#include "G4Neutron.hh"
 #include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <limits>
 
 namespace GdNCap
 {
@@ -40,30 +56,177 @@ namespace GdNCap
 
 EventAction::EventAction(RunAction* runAction)
 : fRunAction(runAction)
-{}
+{
+  fGammaType = ParticleTypeTable::Instance()->Intern("gamma");
+  fNeutron = G4Neutron::Definition();
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void EventAction::BeginOfEventAction(const G4Event*)
 {
+  fEventStart = Clock::now();
+  fEventCpuStart = WorkerTelemetry::GetThreadCpuTime();
   fEdep = 0.;
   fSecE = 0.;
-  fSecL.clear();
+  fNofSteps = 0;
+  fSecEnergy.clear();
+  fSecType.clear();
+  fSecWeight.clear();
+  fCaptureBegin = 0;
+  fCaptureYield = 0.;
+  fTransmission = 0.;
+  fCascadeLibrary = fRunAction->GetCascadeLibrary();
+  if (!fDetConstruction) {
+    fDetConstruction = static_cast<const DetectorConstruction*>(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  }
+  fUserActionTime = std::chrono::duration<G4double>(Clock::now() - fEventStart).count();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EventAction::EndOfEventAction(const G4Event*)
+void EventAction::EndOfEventAction(const G4Event* event)
+{
+  const Clock::time_point actionStart = Clock::now();
+
+  // accumulate statistics in run action; without the secondaries'
+  // transport the energy deposit is incomplete and recorded as NaN
+  const G4bool scoresEdep = fRunAction->GetCaptureFilter()->ScoresEdep();
+  if (scoresEdep) {
+    fRunAction->AddEdep(fEdep);
+    fRunAction->FillHisto(RunAction::kEdepH, fEdep / MeV);
+  }
+  else {
+    fEdep = std::numeric_limits<G4double>::quiet_NaN();
+  }
+  fRunAction->AddSteps(fNofSteps);
+  fRunAction->AddTallies(fCaptureYield, fTransmission);
+  if (!fSecEnergy.empty()) {
+    fRunAction->CountCapture();
+    for (std::size_t i = 0; i < fSecEnergy.size(); ++i) {
+      if (fSecType[i] != fGammaType) continue;
+      fRunAction->FillHisto(RunAction::kGammaEnergyH, fSecEnergy[i], fSecWeight[i]);
+    }
+  }
+  fRunAction->PushSecondaries(event->GetEventID(), fEdep / MeV, fSecE,
+                              fSecEnergy, fSecType, fSecWeight);
+  if (fRunAction->GetOutputMode() == RunAction::OutputMode::Analysis) FillNtuples(event);
+  if (auto monitor = StartupMonitor::Instance()) monitor->EndEvent();
+  if (auto memoryMonitor = MemoryMonitor::Instance()) memoryMonitor->EndEvent();
+
+  const Clock::time_point eventEnd = Clock::now();
+  fUserActionTime += std::chrono::duration<G4double>(eventEnd - actionStart).count();
+  fRunAction->AddEventTime(std::chrono::duration<G4double>(eventEnd - fEventStart).count(),
+                           WorkerTelemetry::GetThreadCpuTime() - fEventCpuStart,
+                           fUserActionTime);
+}
+
+void EventAction::AddCapture(G4double weight, G4double depth)
+{
+  fCaptureYield += weight;
+  fRunAction->FillHisto(RunAction::kCaptureDepthH, depth / mm, weight);
+}
+
+void EventAction::EndCapture()
+{
+  // An event can hold several captures of different weights, with
+  // splitting or forced collision; the products of one capture share the
+  // weight of the captured neutron
+  const std::size_t end = fSecEnergy.size();
+  if (fCaptureBegin == end) return;
+  G4double energy = 0.;
+  G4int nofGammas = 0;
+  for (std::size_t i = fCaptureBegin; i < end; ++i) {
+    energy += fSecEnergy[i];
+    if (fSecType[i] == fGammaType) ++nofGammas;
+  }
+  fRunAction->FillHisto(RunAction::kCaptureEnergyH, energy, fSecWeight[fCaptureBegin]);
+  fRunAction->FillHisto(RunAction::kMultiplicityH, nofGammas, fSecWeight[fCaptureBegin]);
+  fCaptureBegin = end;
+}
+
+void EventAction::ScoreNeutronStep(const G4Step* step)
+{
+  if (step->GetTrack()->GetParticleDefinition() != fNeutron) return;
+  const G4StepPoint* preStepPoint = step->GetPreStepPoint();
+  const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+  const G4VTouchable* touchable = preStepPoint->GetTouchable();
+
+  // The Russian roulette at the end of the step changes the weight after
+  // the step is scored, with the same expected weight
+  G4double postWeight = postStepPoint->GetWeight();
+  const G4bool implicitCapture = fDetConstruction->GetBiasingMode()
+                                 == DetectorConstruction::BiasingMode::ImplicitCapture;
+  if (implicitCapture && fDetConstruction->GetRouletteThreshold() > 0.) {
+    if (const BiasingOperator* biasingOperator = fDetConstruction->GetBiasingOperator()) {
+      postWeight = biasingOperator->GetRoulette()->GetWeightBeforeRoulette(step);
+    }
+  }
+
+  // With implicit capture the weight lost along the step is the expected
+  // capture, scored at the middle of the step
+  if (implicitCapture) {
+    const G4double captured = preStepPoint->GetWeight() - postWeight;
+    if (captured > 0.) {
+      const G4ThreeVector middle =
+        0.5 * (preStepPoint->GetPosition() + postStepPoint->GetPosition());
+      AddCapture(captured, fDetConstruction->GetDepth(touchable, middle));
+    }
+  }
+
+  if (postStepPoint->GetStepStatus() == fGeomBoundary
+      && fDetConstruction->GetDepth(touchable, postStepPoint->GetPosition())
+         > fDetConstruction->GetThickness()
+           - G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()) {
+    fTransmission += postWeight;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::FillNtuples(const G4Event* event) const
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  const G4int eventId = event->GetEventID();
+
+  const G4int eventNtuple = fRunAction->GetEventNtupleId();
+  analysisManager->FillNtupleIColumn(eventNtuple, 0, eventId);
+  analysisManager->FillNtupleDColumn(eventNtuple, 1, fEdep / MeV);
+  analysisManager->FillNtupleDColumn(eventNtuple, 2, fSecE);
+  analysisManager->FillNtupleIColumn(eventNtuple, 3, fSecEnergy.size());
+  analysisManager->AddNtupleRow(eventNtuple);
+
+  const G4int secondaryNtuple = fRunAction->GetSecondaryNtupleId();
+  auto particleTypes = ParticleTypeTable::Instance();
+  for (std::size_t i = 0; i < fSecEnergy.size(); ++i) {
+    analysisManager->FillNtupleIColumn(secondaryNtuple, 0, eventId);
+    analysisManager->FillNtupleDColumn(secondaryNtuple, 1, fSecEnergy[i]);
+    analysisManager->FillNtupleSColumn(secondaryNtuple, 2, particleTypes->GetName(fSecType[i]));
+    analysisManager->FillNtupleDColumn(secondaryNtuple, 3, fSecWeight[i]);
+    analysisManager->AddNtupleRow(secondaryNtuple);
+  }
+}
+
+void EventAction::AddCascade(const G4VProcess* captureProcess,
+                             const std::vector<G4double>& energies)
 {
-  // accumulate statistics in run action
-  fRunAction->AddEdep(fEdep);
-  fRunAction->PushSecondariesList(fSecL);
-  fRunAction->PushSecondariesEnergy(fSecE);
+  // The target nucleus of the capture is still set on this thread's
+  // process instance, wrapped by the biasing physics if any
+  if (auto wrapper = dynamic_cast<const G4BiasingProcessInterface*>(captureProcess)) {
+    captureProcess = wrapper->GetWrappedProcess();
+  }
+  const auto hadronicProcess = dynamic_cast<const G4HadronicProcess*>(captureProcess);
+  if (!hadronicProcess) return;
+  const G4Nucleus* target = hadronicProcess->GetTargetNucleus();
+  fCascadeLibrary->AddCascade(target->GetZ_asInt(), target->GetA_asInt(), energies);
 }
 
-void EventAction::PushSecondary(std::pair<G4double, G4String> fSecondary)
+void EventAction::PushSecondary(G4double energy, const G4String& name, G4double weight)
 {
-	fSecL.push_back(fSecondary);
+	fSecEnergy.push_back(energy);
+	fSecType.push_back(ParticleTypeTable::Instance()->Intern(name));
+	fSecWeight.push_back(weight);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
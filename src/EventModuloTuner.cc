@@ -0,0 +1,119 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/EventModuloTuner.cc
+/// \brief Implementation of the GdNCap::EventModuloTuner class
+
+#include "EventModuloTuner.hh"
+#include "EventModuloTunerMessenger.hh"
+
+#include "G4MTRunManager.hh"
+#include "G4UImanager.hh"
+#include "G4Timer.hh"
+
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EventModuloTuner::EventModuloTuner()
+{
+  fMessenger = new EventModuloTunerMessenger(this);
+}
+
+EventModuloTuner::~EventModuloTuner()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventModuloTuner::Tune(G4int nofEvents)
+{
+  // The tasking run manager derives from the MT one
+  auto runManager = dynamic_cast<G4MTRunManager*>(G4RunManager::GetRunManager());
+  if (!runManager) {
+    G4Exception("EventModuloTuner::Tune()", "MyCode0013", JustWarning,
+      "The event modulo only applies to the MT and tasking run managers.");
+    return;
+  }
+  const G4int nofThreads = runManager->GetNumberOfThreads();
+
+  // The workers take the broadcast output mode at their next run
+  auto UImanager = G4UImanager::GetUIpointer();
+  const G4String outputMode = UImanager->GetCurrentValues("/GdNCap/output/mode");
+  UImanager->ApplyCommand("/GdNCap/output/mode none");
+
+  // Not timed: the first run builds the physics tables and starts the workers
+  runManager->SetEventModulo(1);
+  runManager->BeamOn(nofEvents);
+
+  std::vector<std::pair<G4int, G4double>> rates;
+  G4int bestModulo = 1;
+  G4double bestRate = 0.;
+  for (G4int modulo : { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 }) {
+    // Every thread should get a chunk
+    if (modulo > 1 && modulo * nofThreads > nofEvents) break;
+    runManager->SetEventModulo(modulo);
+    G4Timer timer;
+    timer.Start();
+    runManager->BeamOn(nofEvents);
+    timer.Stop();
+    const G4double rate =
+      timer.GetRealElapsed() > 0. ? nofEvents / timer.GetRealElapsed() : 0.;
+    rates.emplace_back(modulo, rate);
+    if (rate > bestRate) {
+      bestRate = rate;
+      bestModulo = modulo;
+    }
+  }
+
+  runManager->SetEventModulo(bestModulo);
+  if (!outputMode.empty()) UImanager->ApplyCommand("/GdNCap/output/mode " + outputMode);
+
+  G4cout
+    << G4endl
+    << "--------------------Event modulo tuning---------------------"
+    << G4endl
+    << " " << nofEvents << " events per run on " << nofThreads << " threads"
+    << G4endl;
+  for (const auto& [modulo, rate] : rates) {
+    G4cout
+      << " modulo " << std::setw(5) << modulo << ": " << rate << " events/s"
+      << (modulo == bestModulo ? "  <- kept" : "") << G4endl;
+  }
+  G4cout
+    << "------------------------------------------------------------"
+    << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,78 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/EventModuloTunerMessenger.cc
+/// \brief Implementation of the GdNCap::EventModuloTunerMessenger class
+
+#include "EventModuloTunerMessenger.hh"
+#include "EventModuloTuner.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EventModuloTunerMessenger::EventModuloTunerMessenger(EventModuloTuner* tuner)
+: fTuner(tuner)
+{
+  fDirectory = new G4UIdirectory("/GdNCap/run/", false);
+  fDirectory->SetGuidance("Event dispatch of the multi-threaded run managers.");
+
+  fTuneCmd = new G4UIcmdWithAnInteger("/GdNCap/run/tuneEventModulo", this);
+  fTuneCmd->SetGuidance("Run short calibration runs of the current source, without");
+  fTuneCmd->SetGuidance("storing records, and keep the event modulo (/run/eventModulo)");
+  fTuneCmd->SetGuidance("of the highest throughput. The parameter is the number of");
+  fTuneCmd->SetGuidance("events of each calibration run (default: 2000).");
+  fTuneCmd->SetParameterName("events", true);
+  fTuneCmd->SetDefaultValue(2000);
+  fTuneCmd->SetRange("events > 0");
+  fTuneCmd->AvailableForStates(G4State_Idle);
+  fTuneCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EventModuloTunerMessenger::~EventModuloTunerMessenger()
+{
+  delete fTuneCmd;
+  delete fDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventModuloTunerMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fTuneCmd) {
+    fTuner->Tune(fTuneCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,229 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/src/GeometrySweep.cc
+/// \brief Implementation of the GdNCap::GeometrySweep class
+
+#include "GeometrySweep.hh"
+#include "GeometrySweepMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "RunSummary.hh"
+
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4UIcommand.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GeometrySweep::GeometrySweep(DetectorConstruction* detConstruction)
+: fDetConstruction(detConstruction)
+{
+  fMessenger = new GeometrySweepMessenger(this);
+}
+
+GeometrySweep::~GeometrySweep()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GeometrySweep::SetEnergies(const std::vector<G4double>& energies, const G4String& unit)
+{
+  SetAxis(fEnergies, energies, unit);
+}
+
+void GeometrySweep::SetThicknesses(const std::vector<G4double>& thicknesses,
+                                   const G4String& unit)
+{
+  SetAxis(fThicknesses, thicknesses, unit);
+}
+
+void GeometrySweep::SetMaterials(const std::vector<G4String>& materials)
+{
+  // Defined now, so that their data is loaded by /run/initialize
+  fMaterials.clear();
+  for (const auto& material : materials) {
+    if (fDetConstruction->AddMaterial(material)) fMaterials.push_back(material);
+  }
+}
+
+void GeometrySweep::SetAxis(Axis& axis, const std::vector<G4double>& values,
+                            const G4String& unit)
+{
+  axis.fValues = values;
+  axis.fUnit = unit;
+  axis.fUnitValue = values.empty() ? 1. : G4UIcommand::ValueOf(unit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String GeometrySweep::FormatValue(const Axis& axis, G4double value) const
+{
+  // As given in the command, e.g. 0.0253eV
+  std::ostringstream os;
+  os << value / axis.fUnitValue << axis.fUnit;
+  return os.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool GeometrySweep::Apply(const G4String& command) const
+{
+  const G4int status = G4UImanager::GetUIpointer()->ApplyCommand(command);
+  if (status == fCommandSucceeded) return true;
+
+  G4ExceptionDescription msg;
+  msg << "Command \"" << command << "\" failed with status " << status
+      << ", the sweep is stopped.";
+  G4Exception("GeometrySweep::Run()", "MyCode0015", JustWarning, msg);
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GeometrySweep::Run(G4int nofEvents)
+{
+  if (fEnergies.fValues.empty() && fThicknesses.fValues.empty() && fMaterials.empty()) {
+    G4Exception("GeometrySweep::Run()", "MyCode0015", JustWarning,
+      "Nothing to sweep: set /GdNCap/sweep/energies, thicknesses or materials.");
+    return;
+  }
+
+  // An axis that is not swept has a single point keeping the current
+  // setting, 0 or an empty name
+  struct Point
+  {
+    G4String fMaterial;
+    G4double fThickness = 0.;
+    G4double fEnergy = 0.;
+  };
+  const std::vector<G4String> materials =
+    fMaterials.empty() ? std::vector<G4String>{ "" } : fMaterials;
+  const std::vector<G4double> thicknesses =
+    fThicknesses.fValues.empty() ? std::vector<G4double>{ 0. } : fThicknesses.fValues;
+  const std::vector<G4double> energies =
+    fEnergies.fValues.empty() ? std::vector<G4double>{ 0. } : fEnergies.fValues;
+
+  // Materials outermost: the geometry changes least often
+  std::vector<Point> points;
+  for (const auto& material : materials) {
+    for (G4double thickness : thicknesses) {
+      for (G4double energy : energies) points.push_back({ material, thickness, energy });
+    }
+  }
+
+  // Restored after the sweep; on an MT master the current gun energy is
+  // the one kept by GeometrySweepMessenger
+  auto UImanager = G4UImanager::GetUIpointer();
+  const G4String outputTag = UImanager->GetCurrentValues("/GdNCap/output/tag");
+  const G4String material = UImanager->GetCurrentValues("/GdNCap/detector/material");
+  const G4String thickness = UImanager->GetCurrentValues("/GdNCap/detector/thickness");
+  const G4String energy = UImanager->GetCurrentValues("/gun/energy");
+
+  std::ofstream index(fIndexFile);
+  index << "# tag material thickness[mm] energy[MeV] events seconds" << std::endl;
+
+  G4cout
+    << G4endl
+    << "--------------------Geometry sweep--------------------------"
+    << G4endl
+    << " " << points.size() << " points of " << nofEvents << " events"
+    << G4endl;
+
+  auto runManager = G4RunManager::GetRunManager();
+  std::size_t nofDone = 0;
+  for (const auto& point : points) {
+    G4String tag;
+    auto addToTag = [&tag](const G4String& part) { tag += (tag.empty() ? "" : "_") + part; };
+    if (point.fEnergy > 0.) addToTag("E" + FormatValue(fEnergies, point.fEnergy));
+    if (point.fThickness > 0.) addToTag("T" + FormatValue(fThicknesses, point.fThickness));
+    if (!point.fMaterial.empty()) addToTag(point.fMaterial);
+
+    // The detector commands rebuild the geometry when the value changes
+    G4bool applied =
+      (point.fMaterial.empty() || Apply("/GdNCap/detector/material " + point.fMaterial))
+      && (point.fThickness <= 0.
+          || Apply("/GdNCap/detector/thickness "
+                   + G4UIcommand::ConvertToString(point.fThickness / mm) + " mm"))
+      && (point.fEnergy <= 0.
+          || Apply("/gun/energy " + G4UIcommand::ConvertToString(point.fEnergy / MeV) + " MeV"))
+      && Apply("/GdNCap/output/tag " + tag);
+    if (!applied) break;
+
+    G4cout << " point " << nofDone + 1 << "/" << points.size() << ": " << tag << G4endl;
+    G4Timer timer;
+    timer.Start();
+    runManager->BeamOn(nofEvents);
+    timer.Stop();
+    ++nofDone;
+
+    index
+      << tag << ' ' << (point.fMaterial.empty() ? G4String("-") : point.fMaterial) << ' ';
+    if (point.fThickness > 0.) index << point.fThickness / mm << ' ';
+    else index << "- ";
+    if (point.fEnergy > 0.) index << point.fEnergy / MeV << ' ';
+    else index << "- ";
+    index << nofEvents << ' ' << timer.GetRealElapsed() << std::endl;
+
+    std::ostringstream entry;
+    entry << tag << ' ' << nofEvents << ' ' << timer.GetRealElapsed();
+    RunSummary::Instance()->AddEntry("sweepPoint", entry.str());
+  }
+
+  UImanager->ApplyCommand("/GdNCap/output/tag " + (outputTag.empty() ? G4String("none") : outputTag));
+  if (!material.empty()) UImanager->ApplyCommand("/GdNCap/detector/material " + material);
+  if (!thickness.empty()) UImanager->ApplyCommand("/GdNCap/detector/thickness " + thickness);
+  if (!fEnergies.fValues.empty()) {
+    if (!energy.empty()) {
+      UImanager->ApplyCommand("/gun/energy " + energy);
+    }
+    else {
+      G4Exception("GeometrySweep::Run()", "MyCode0015", JustWarning,
+        "The gun energy could not be read back and is not restored: it stays at"
+        " the last point of the sweep, set /gun/energy before the next run.");
+    }
+  }
+
+  G4cout
+    << " " << nofDone << " of " << points.size() << " points run, listed in "
+    << fIndexFile << G4endl
+    << "------------------------------------------------------------"
+    << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
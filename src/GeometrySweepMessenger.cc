@@ -0,0 +1,198 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/src/GeometrySweepMessenger.cc
+/// \brief Implementation of the GdNCap::GeometrySweepMessenger class
+
+#include "GeometrySweepMessenger.hh"
+#include "GeometrySweep.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcommandTree.hh"
+#include "G4UImanager.hh"
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+  std::vector<G4String> SplitNames(const G4String& value)
+  {
+    std::vector<G4String> names;
+    std::istringstream is(value);
+    G4String name;
+    while (is >> name) names.push_back(name);
+    return names;
+  }
+
+  // "values... unit" with a unit of the category, the values converted
+  // to Geant4 units; false if the list is malformed
+  G4bool ParseValues(const G4String& value, const G4String& category,
+                     std::vector<G4double>& values, G4String& unit)
+  {
+    std::vector<G4String> tokens = SplitNames(value);
+    if (tokens.size() < 2) return false;
+    unit = tokens.back();
+    tokens.pop_back();
+    if (G4UIcommand::CategoryOf(unit) != category) return false;
+    const G4double unitValue = G4UIcommand::ValueOf(unit);
+    values.clear();
+    for (const auto& token : tokens) {
+      std::istringstream is(token);
+      G4double number = 0.;
+      if (!(is >> number) || !is.eof() || number <= 0.) return false;
+      values.push_back(number * unitValue);
+    }
+    return true;
+  }
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GeometrySweepMessenger::GeometrySweepMessenger(GeometrySweep* sweep)
+: fSweep(sweep)
+{
+  fDirectory = new G4UIdirectory("/GdNCap/sweep/", false);
+  fDirectory->SetGuidance("Grid of energies, thicknesses and materials run in one job.");
+
+  fEnergiesCmd = new G4UIcmdWithAString("/GdNCap/sweep/energies", this);
+  fEnergiesCmd->SetGuidance("Energies of the gun followed by their unit,");
+  fEnergiesCmd->SetGuidance("e.g. \"0.0253 1 1000 eV\"; \"none\" keeps /gun/energy.");
+  fEnergiesCmd->SetParameterName("energies", false);
+  fEnergiesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEnergiesCmd->SetToBeBroadcasted(false);
+
+  fThicknessesCmd = new G4UIcmdWithAString("/GdNCap/sweep/thicknesses", this);
+  fThicknessesCmd->SetGuidance("Thicknesses of the envelope followed by their unit,");
+  fThicknessesCmd->SetGuidance("e.g. \"0.1 1 10 mm\"; \"none\" keeps /GdNCap/detector/thickness.");
+  fThicknessesCmd->SetParameterName("thicknesses", false);
+  fThicknessesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fThicknessesCmd->SetToBeBroadcasted(false);
+
+  fMaterialsCmd = new G4UIcmdWithAString("/GdNCap/sweep/materials", this);
+  fMaterialsCmd->SetGuidance("Materials of the envelope separated by spaces,");
+  fMaterialsCmd->SetGuidance("e.g. \"myGd155 myGd157 G4_Gd\"; \"none\" keeps");
+  fMaterialsCmd->SetGuidance("/GdNCap/detector/material. Set before /run/initialize, so that");
+  fMaterialsCmd->SetGuidance("the data of the NIST materials is loaded with the physics tables.");
+  fMaterialsCmd->SetParameterName("materials", false);
+  fMaterialsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fMaterialsCmd->SetToBeBroadcasted(false);
+
+  fIndexFileCmd = new G4UIcmdWithAString("/GdNCap/sweep/indexFile", this);
+  fIndexFileCmd->SetGuidance("File listing the points of the sweep (default: Sweep.txt).");
+  fIndexFileCmd->SetParameterName("fileName", false);
+  fIndexFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fIndexFileCmd->SetToBeBroadcasted(false);
+
+  fRunCmd = new G4UIcmdWithAnInteger("/GdNCap/sweep/run", this);
+  fRunCmd->SetGuidance("Run every point of the grid with the given number of events,");
+  fRunCmd->SetGuidance("rebuilding only the geometry between them.");
+  fRunCmd->SetParameterName("events", false);
+  fRunCmd->SetRange("events > 0");
+  fRunCmd->AvailableForStates(G4State_Idle);
+  fRunCmd->SetToBeBroadcasted(false);
+
+  // With the same parameter as in G4ParticleGunMessenger; the gun of a
+  // sequential run defines it before
+  if (!G4UImanager::GetUIpointer()->GetTree()->FindPath("/gun/energy")) {
+    fGunDirectory = new G4UIdirectory("/gun/", false);
+    fGunDirectory->SetGuidance("Particle gun of the worker threads.");
+
+    fGunEnergyCmd = new G4UIcmdWithADoubleAndUnit("/gun/energy", this);
+    fGunEnergyCmd->SetGuidance("Set kinetic energy.");
+    fGunEnergyCmd->SetGuidance("Kept on the master for /GdNCap/sweep/run to restore it.");
+    fGunEnergyCmd->SetParameterName("Energy", true, true);
+    fGunEnergyCmd->SetDefaultUnit("GeV");
+    fGunEnergy = PrimaryGeneratorAction::kDefaultEnergy;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+GeometrySweepMessenger::~GeometrySweepMessenger()
+{
+  delete fRunCmd;
+  delete fIndexFileCmd;
+  delete fMaterialsCmd;
+  delete fThicknessesCmd;
+  delete fEnergiesCmd;
+  delete fDirectory;
+  delete fGunEnergyCmd;
+  delete fGunDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void GeometrySweepMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fEnergiesCmd || command == fThicknessesCmd) {
+    const G4bool energies = (command == fEnergiesCmd);
+    std::vector<G4double> values;
+    G4String unit;
+    if (newValue == "none") {
+      // clears the axis
+    }
+    else if (!ParseValues(newValue, energies ? "Energy" : "Length", values, unit)) {
+      G4ExceptionDescription msg;
+      msg << "Expected positive values followed by a unit of "
+          << (energies ? "energy" : "length") << ", got \"" << newValue << "\".";
+      G4Exception("GeometrySweepMessenger::SetNewValue()", "MyCode0015", JustWarning, msg);
+      return;
+    }
+    if (energies) fSweep->SetEnergies(values, unit);
+    else fSweep->SetThicknesses(values, unit);
+  }
+  else if (command == fMaterialsCmd) {
+    fSweep->SetMaterials(newValue == "none" ? std::vector<G4String>() : SplitNames(newValue));
+  }
+  else if (command == fIndexFileCmd) {
+    fSweep->SetIndexFile(newValue);
+  }
+  else if (command == fRunCmd) {
+    fSweep->Run(fRunCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fGunEnergyCmd) {
+    fGunEnergy = fGunEnergyCmd->GetNewDoubleValue(newValue);
+  }
+}
+
+G4String GeometrySweepMessenger::GetCurrentValue(G4UIcommand* command)
+{
+  if (command == fGunEnergyCmd) return fGunEnergyCmd->ConvertToString(fGunEnergy, "GeV");
+  return "";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,126 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/HPDataSubset.cc
+/// \brief Implementation of the GdNCap::HPDataSubset class
+
+#include "HPDataSubset.hh"
+#include "HPDataSubsetFormat.hh"
+
+#include "G4StateManager.hh"
+#include "G4Element.hh"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GDNCAP_HAVE_SETENV 1
+#endif
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+HPDataSubset::HPDataSubset(const G4String& directory)
+: fDirectory(directory)
+{
+  std::ifstream manifest(fDirectory + "/" + HPDataSubsetFormat::kManifestName);
+  std::string line;
+  while (std::getline(manifest, line)) {
+    std::istringstream is(line);
+    std::string key;
+    is >> key;
+    if (key == "source") {
+      is >> fSource;
+    }
+    else if (key == "elements") {
+      G4int z = 0;
+      while (is >> z) fElements.insert(z);
+    }
+  }
+  if (fElements.empty()) {
+    G4ExceptionDescription msg;
+    msg << fDirectory << " is not a neutron HP data subset made by gdncap-hpprep.";
+    G4Exception("HPDataSubset::HPDataSubset()", "MyCode0012", FatalException, msg);
+    return;
+  }
+
+#ifdef GDNCAP_HAVE_SETENV
+  setenv("G4NEUTRONHPDATA", fDirectory.c_str(), 1);
+#else
+  _putenv_s("G4NEUTRONHPDATA", fDirectory.c_str());
+#endif
+
+  G4cout << " Neutron HP data: subset of " << fSource << " in " << fDirectory
+         << ", Z =";
+  for (auto z : fElements) G4cout << " " << z;
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool HPDataSubset::Notify(G4ApplicationState requestedState)
+{
+  // Called before the change: Init -> Idle ends /run/initialize, the
+  // materials are all built and the HP data not read yet
+  const G4ApplicationState state = G4StateManager::GetStateManager()->GetCurrentState();
+  if (!fChecked && state == G4State_Init && requestedState == G4State_Idle) {
+    fChecked = true;
+    CheckElements();
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HPDataSubset::CheckElements() const
+{
+  // ParticleHP builds its data for every element of the table
+  std::set<G4int> missing;
+  for (auto element : *G4Element::GetElementTable()) {
+    const auto z = G4lrint(element->GetZ());
+    if (fElements.count(z) == 0) missing.insert(z);
+  }
+  if (missing.empty()) return;
+
+  std::set<G4int> elements(fElements);
+  elements.insert(missing.begin(), missing.end());
+  G4ExceptionDescription msg;
+  msg << "The neutron HP data subset in " << fDirectory << " lacks Z =";
+  for (auto z : missing) msg << " " << z;
+  msg << ", remake it with" << G4endl << "  gdncap-hpprep -z ";
+  for (auto it = elements.begin(); it != elements.end(); ++it) {
+    msg << (it == elements.begin() ? "" : ",") << *it;
+  }
+  msg << " " << fSource << " <directory>";
+  G4Exception("HPDataSubset::CheckElements()", "MyCode0012", FatalException, msg);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,196 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/IndexedRecordWriter.cc
+/// \brief Implementation of the GdNCap::IndexedRecordWriter class
+
+#include "IndexedRecordWriter.hh"
+#include "TextFormat.hh"
+
+namespace
+{
+  const std::size_t kIndexBufferSize = 4096;
+
+  // Size of the buffered output above which Write() passes it to the files
+  const std::size_t kBufferSize = 1 << 20;
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+IndexedRecordWriter::~IndexedRecordWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String IndexedRecordWriter::GetRecordFileName(const G4String& suffix)
+{
+  return "CaptureRecords" + suffix + ".txt";
+}
+
+G4String IndexedRecordWriter::GetIndexFileName(const G4String& suffix)
+{
+  return "CaptureRecords" + suffix + ".idx";
+}
+
+std::vector<G4String> IndexedRecordWriter::GetFileNames(const G4String& suffix) const
+{
+  return { GetRecordFileName(suffix), GetIndexFileName(suffix) };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IndexedRecordWriter::Open(const G4String& suffix)
+{
+  Close();
+  fRecordFile.open(GetRecordFileName(suffix), std::ios_base::out | std::ios_base::binary);
+  fIndexFile.open(GetIndexFileName(suffix), std::ios_base::out | std::ios_base::binary);
+  fNofEvents = 0;
+  fNofSecondaries = 0;
+
+  const std::string header = fWeighted
+    ? "# eventID edep[MeV] totalEnergy[MeV] n {energy[MeV] type weight}\n"
+    : "# eventID edep[MeV] totalEnergy[MeV] n {energy[MeV] type}\n";
+  fRecordFile.write(header.data(), header.size());
+  fOffset = header.size();
+
+  // The record count is patched in Close()
+  const std::uint64_t nofRecords = 0;
+  fIndexFile.write(kIndexMagic, 8);
+  fIndexFile.write(reinterpret_cast<const char*>(&nofRecords), sizeof(nofRecords));
+  fPendingOffsets.clear();
+  fPendingOffsets.reserve(kIndexBufferSize);
+  fChunk.Clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IndexedRecordWriter::Write(const CaptureRecordView::Event& event)
+{
+  FormatEvent(event, fChunk);
+  if (fChunk.GetSize() >= kBufferSize) {
+    WriteChunk(fChunk);
+    fChunk.Clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IndexedRecordWriter::FormatChunk(const std::vector<CaptureRecordView::Event>& events,
+                                      Chunk& chunk) const
+{
+  chunk.Clear();
+  chunk.fRecordEnds.reserve(events.size());
+  for (const auto& event : events) FormatEvent(event, chunk);
+}
+
+void IndexedRecordWriter::FormatEvent(const CaptureRecordView::Event& event,
+                                      Chunk& chunk) const
+{
+  if (chunk.fBuffers.empty()) chunk.fBuffers.resize(1);
+  auto& line = chunk.fBuffers.front();
+
+  TextFormat::AppendInteger(line, event.GetEventId());
+  line += ' ';
+  TextFormat::Append(line, event.GetEdep());
+  line += ' ';
+  TextFormat::Append(line, event.GetTotalEnergy());
+  line += ' ';
+  TextFormat::AppendInteger(line, event.GetNumberOfSecondaries());
+  for (std::size_t i = 0; i < event.GetNumberOfSecondaries(); ++i) {
+    line += ' ';
+    TextFormat::Append(line, event.GetEnergy(i));
+    line += ' ';
+    line += event.GetTypeName(i);
+    if (fWeighted) {
+      line += ' ';
+      TextFormat::Append(line, event.GetWeight(i));
+    }
+  }
+  line += '\n';
+
+  chunk.fRecordEnds.push_back(line.size());
+  ++chunk.fNofEvents;
+  chunk.fNofSecondaries += event.GetNumberOfSecondaries();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IndexedRecordWriter::WriteChunk(const Chunk& chunk)
+{
+  if (chunk.fBuffers.empty()) return;
+
+  // Index entries are the record starts: the file offset of the chunk,
+  // then the end of every record but the last
+  std::uint64_t recordStart = fOffset;
+  for (auto recordEnd : chunk.fRecordEnds) {
+    fPendingOffsets.push_back(recordStart);
+    if (fPendingOffsets.size() == kIndexBufferSize) FlushIndex();
+    recordStart = fOffset + recordEnd;
+  }
+
+  const auto& lines = chunk.fBuffers.front();
+  fRecordFile.write(lines.data(), lines.size());
+  fOffset += lines.size();
+  fNofEvents += chunk.fNofEvents;
+  fNofSecondaries += chunk.fNofSecondaries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IndexedRecordWriter::FlushIndex()
+{
+  fIndexFile.write(reinterpret_cast<const char*>(fPendingOffsets.data()),
+                   fPendingOffsets.size() * sizeof(std::uint64_t));
+  fPendingOffsets.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void IndexedRecordWriter::Close()
+{
+  if (!IsOpen()) return;
+  WriteChunk(fChunk);
+  fChunk.Clear();
+
+  // Terminating offset, then the final record count in the header
+  fPendingOffsets.push_back(fOffset);
+  FlushIndex();
+  const std::uint64_t nofRecords = fNofEvents;
+  fIndexFile.seekp(8);
+  fIndexFile.write(reinterpret_cast<const char*>(&nofRecords), sizeof(nofRecords));
+
+  fIndexFile.close();
+  fRecordFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,185 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/MemoryMonitor.cc
+/// \brief Implementation of the GdNCap::MemoryMonitor class
+
+#include "MemoryMonitor.hh"
+#include "MemoryMonitorMessenger.hh"
+#include "RunSummary.hh"
+
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GDNCAP_HAVE_GETRUSAGE 1
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  G4Mutex sampleMutex = G4MUTEX_INITIALIZER;
+}
+
+namespace GdNCap
+{
+
+MemoryMonitor* MemoryMonitor::fgInstance = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MemoryMonitor::MemoryMonitor()
+{
+  fgInstance = this;
+  fMessenger = new MemoryMonitorMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MemoryMonitor::~MemoryMonitor()
+{
+  delete fMessenger;
+  fgInstance = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double MemoryMonitor::GetResidentSize()
+{
+#ifdef GDNCAP_HAVE_GETRUSAGE
+  // The second field of statm is the resident size in pages; Linux only
+  std::ifstream statm("/proc/self/statm");
+  long size = 0, resident = 0;
+  if (!(statm >> size >> resident)) return 0.;
+  return resident * (sysconf(_SC_PAGESIZE) / (1024. * 1024.));
+#else
+  return 0.;
+#endif
+}
+
+G4double MemoryMonitor::GetPeakResidentSize()
+{
+#ifdef GDNCAP_HAVE_GETRUSAGE
+  struct rusage usage = {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.;
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024. * 1024.);
+#else
+  return usage.ru_maxrss / 1024.;
+#endif
+#else
+  return 0.;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MemoryMonitor::BeginRun(G4int nofEvents)
+{
+  fNofEvents = nofEvents;
+  fStart = Clock::now();
+  fStartSize = GetResidentSize();
+  fNofProcessed = 0;
+  fWarned = false;
+  fSamples.clear();
+  fSamples.emplace_back("beginOfRun", fStartSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MemoryMonitor::EndEvent()
+{
+  const G4long nofProcessed = ++fNofProcessed;
+  if (fBudget <= 0. || nofProcessed % kCheckInterval != 0 || fWarned) return;
+  Check(nofProcessed);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MemoryMonitor::Check(G4long nofProcessed)
+{
+  const G4double size = GetResidentSize();
+  const G4double elapsed = std::chrono::duration<G4double>(Clock::now() - fStart).count();
+  if (size <= 0. || elapsed <= 0.) return;
+
+  // Linear growth with the events, at the event rate so far
+  const G4double growth = (size - fStartSize) / nofProcessed;
+  const G4double eventRate = nofProcessed / elapsed;
+  const G4long remaining = std::max(G4long(fNofEvents) - nofProcessed, G4long(0));
+  const G4double projected = size + growth * remaining;
+  if (projected <= fBudget && size <= fBudget) return;
+  if (fWarned.exchange(true)) return;
+
+  G4ExceptionDescription msg;
+  msg << "The RSS is " << size << " MB after " << nofProcessed << " of " << fNofEvents
+      << " events and grows by " << growth * 1024. << " kB per event at "
+      << eventRate << " events/s:";
+  if (size > fBudget) {
+    msg << " the budget of " << fBudget << " MB is exceeded,";
+  }
+  else {
+    msg << " the budget of " << fBudget << " MB will be exceeded in "
+        << (fBudget - size) / (growth * eventRate) << " s,";
+  }
+  msg << " " << projected << " MB are expected at the end of the event loop,"
+      << " before the merge and the output.";
+  G4Exception("MemoryMonitor::Check()", "MyCode0014", JustWarning, msg);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MemoryMonitor::Sample(const G4String& point)
+{
+  // Repeated samples of a point, e.g. one per worker, keep the largest
+  const G4double size = GetResidentSize();
+  G4AutoLock lock(&sampleMutex);
+  auto sample = std::find_if(fSamples.begin(), fSamples.end(),
+    [&point](const std::pair<G4String, G4double>& s) { return s.first == point; });
+  if (sample == fSamples.end()) fSamples.emplace_back(point, size);
+  else sample->second = std::max(sample->second, size);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MemoryMonitor::Report() const
+{
+  const G4double peak = GetPeakResidentSize();
+  G4cout << G4endl << " Memory: RSS";
+  for (const auto& [point, size] : fSamples) {
+    G4cout << " " << point << " " << size << " MB,";
+    RunSummary::Instance()->AddEntry("memory", point + " " + std::to_string(size));
+  }
+  G4cout << " peak " << peak << " MB";
+  if (fBudget > 0.) G4cout << " (budget " << fBudget << " MB)";
+  RunSummary::Instance()->AddEntry("memory", "peak " + std::to_string(peak));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
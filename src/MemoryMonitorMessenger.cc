@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/MemoryMonitorMessenger.cc
+/// \brief Implementation of the GdNCap::MemoryMonitorMessenger class
+
+#include "MemoryMonitorMessenger.hh"
+#include "MemoryMonitor.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADouble.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MemoryMonitorMessenger::MemoryMonitorMessenger(MemoryMonitor* monitor)
+: fMonitor(monitor)
+{
+  fDirectory = new G4UIdirectory("/GdNCap/memory/", false);
+  fDirectory->SetGuidance("Memory accounting of the runs");
+
+  fBudgetCmd = new G4UIcmdWithADouble("/GdNCap/memory/budget", this);
+  fBudgetCmd->SetGuidance("Budget of the resident memory of the job in MB, 0 for none.");
+  fBudgetCmd->SetGuidance("Every 1000 events the growth of the resident memory is");
+  fBudgetCmd->SetGuidance("projected to the end of the run, with a warning when it");
+  fBudgetCmd->SetGuidance("would exceed the budget.");
+  fBudgetCmd->SetParameterName("MB", false);
+  fBudgetCmd->SetRange("MB >= 0");
+  fBudgetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fBudgetCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MemoryMonitorMessenger::~MemoryMonitorMessenger()
+{
+  delete fBudgetCmd;
+  delete fDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MemoryMonitorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fBudgetCmd) {
+    fMonitor->SetBudget(fBudgetCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
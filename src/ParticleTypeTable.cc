@@ -0,0 +1,79 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/ParticleTypeTable.cc
+/// \brief Implementation of the GdNCap::ParticleTypeTable class
+
+#include "ParticleTypeTable.hh"
+
+#include "G4AutoLock.hh"
+
+namespace
+{
+  G4Mutex internMutex = G4MUTEX_INITIALIZER;
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ParticleTypeTable* ParticleTypeTable::Instance()
+{
+  static ParticleTypeTable instance;
+  return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ParticleTypeTable::TypeId ParticleTypeTable::Intern(const G4String& name)
+{
+  // Names are only ever appended, so the published prefix can be
+  // scanned without holding the lock
+  std::size_t nofTypes = fNofTypes.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < nofTypes; ++i) {
+    if (fNames[i] == name) return static_cast<TypeId>(i);
+  }
+
+  G4AutoLock lock(&internMutex);
+  nofTypes = fNofTypes.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < nofTypes; ++i) {
+    if (fNames[i] == name) return static_cast<TypeId>(i);
+  }
+  if (nofTypes == kMaxTypes) {
+    G4ExceptionDescription msg;
+    msg << "Too many distinct secondary types, cannot intern " << name;
+    G4Exception("ParticleTypeTable::Intern()", "MyCode0003",
+      FatalException, msg);
+  }
+  fNames[nofTypes] = name;
+  fNofTypes.store(nofTypes + 1, std::memory_order_release);
+  return static_cast<TypeId>(nofTypes);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,177 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/PhysicsListComparison.cc
+/// \brief Implementation of the GdNCap::PhysicsListComparison class
+
+#include "PhysicsListComparison.hh"
+#include "RunSummary.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsListComparison::PhysicsListComparison(const G4String& program,
+                                             const G4String& macro,
+                                             const std::vector<G4String>& arguments)
+: fChild(program),
+  fMacro(ChildProcess::GetAbsolutePath(macro)),
+  fArguments(arguments)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhysicsListComparison::Run(const std::vector<G4String>& physicsLists)
+{
+  std::vector<Result> results;
+  for (const auto& physicsList : physicsLists) {
+    G4cout << " Running " << fMacro << " with " << physicsList << " ..." << G4endl;
+    Result result;
+    result.fPhysicsList = physicsList;
+    const G4String directory = "compare_" + physicsList;
+    std::vector<G4String> arguments = { "-p", physicsList, "-r", "summary.txt" };
+    arguments.insert(arguments.end(), fArguments.begin(), fArguments.end());
+    arguments.push_back(fMacro);
+    result.fSucceeded = fChild.Run(arguments, directory);
+    result.fPeakMemory = fChild.GetPeakMemory();
+    if (result.fSucceeded) {
+      result.fTotals = RunSummary::GetTotals(RunSummary::Read(directory + "/summary.txt"));
+      ReadSpectrum(directory + "/Histo_gammaEnergy.txt", result);
+      if (!results.empty() && results.front().fSucceeded) {
+        CompareSpectra(results.front(), result);
+      }
+    }
+    results.push_back(result);
+  }
+  Print(results);
+  return std::all_of(results.begin(), results.end(),
+                     [](const Result& result) { return result.fSucceeded; });
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsListComparison::ReadSpectrum(const G4String& fileName, Result& result) const
+{
+  // Layout of H1Accumulable::Write()
+  std::ifstream file(fileName);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream is(line);
+    G4double lowEdge = 0., highEdge = 0., content = 0., error = 0.;
+    if (!(is >> lowEdge >> highEdge >> content >> error)) continue;
+    result.fSpectrum.push_back(content);
+    result.fSpectrumError2.push_back(error * error);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsListComparison::CompareSpectra(const Result& reference, Result& result) const
+{
+  const std::size_t nbins = reference.fSpectrum.size();
+  if (nbins == 0 || result.fSpectrum.size() != nbins) return;
+  if (reference.fTotals.fLastRunEvents == 0 || result.fTotals.fLastRunEvents == 0) return;
+
+  // Spectra per event, so a change of the capture yield counts too
+  const G4double scale1 = 1. / reference.fTotals.fLastRunEvents;
+  const G4double scale2 = 1. / result.fTotals.fLastRunEvents;
+  G4double sum1 = 0., sum2 = 0.;
+  for (std::size_t bin = 0; bin < nbins; ++bin) {
+    const G4double variance = reference.fSpectrumError2[bin] * scale1 * scale1
+                            + result.fSpectrumError2[bin] * scale2 * scale2;
+    if (variance > 0.) {
+      const G4double difference = reference.fSpectrum[bin] * scale1
+                                - result.fSpectrum[bin] * scale2;
+      result.fChi2 += difference * difference / variance;
+      ++result.fNdf;
+    }
+    sum1 += reference.fSpectrum[bin];
+    sum2 += result.fSpectrum[bin];
+  }
+
+  // Shapes only
+  if (sum1 <= 0. || sum2 <= 0.) return;
+  G4double cumulative1 = 0., cumulative2 = 0.;
+  for (std::size_t bin = 0; bin < nbins; ++bin) {
+    cumulative1 += reference.fSpectrum[bin] / sum1;
+    cumulative2 += result.fSpectrum[bin] / sum2;
+    result.fKolmogorovDistance =
+      std::max(result.fKolmogorovDistance, std::abs(cumulative1 - cumulative2));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsListComparison::Print(const std::vector<Result>& results) const
+{
+  G4cout
+    << G4endl
+    << "--------------------Physics list comparison-----------------"
+    << G4endl
+    << " " << fMacro << ", spectra against " << results.front().fPhysicsList
+    << G4endl
+    << " " << std::left << std::setw(20) << "list" << std::right
+    << std::setw(10) << "init[s]" << std::setw(12) << "events/s"
+    << std::setw(12) << "memory[MB]" << std::setw(12) << "chi2/ndf"
+    << std::setw(8) << "KS" << G4endl;
+  for (const auto& result : results) {
+    G4cout << " " << std::left << std::setw(20) << result.fPhysicsList << std::right;
+    if (!result.fSucceeded) {
+      G4cout << " failed, see compare_" << result.fPhysicsList << "/log.txt" << G4endl;
+      continue;
+    }
+    G4cout
+      << std::setw(10) << std::setprecision(3) << result.fTotals.fInitTime
+      << std::setw(12) << std::setprecision(4)
+      << (result.fTotals.fEventTime > 0.
+          ? result.fTotals.fNofEvents / result.fTotals.fEventTime : 0.)
+      << std::setw(12) << std::setprecision(4) << result.fPeakMemory;
+    if (result.fNdf > 0) {
+      G4cout
+        << std::setw(12) << std::setprecision(3) << result.fChi2 / result.fNdf
+        << std::setw(8) << std::setprecision(3) << result.fKolmogorovDistance;
+    }
+    else {
+      G4cout << std::setw(12) << "-" << std::setw(8) << "-";
+    }
+    G4cout << G4endl;
+  }
+  G4cout
+    << "------------------------------------------------------------"
+    << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
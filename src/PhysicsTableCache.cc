@@ -0,0 +1,229 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/PhysicsTableCache.cc
+/// \brief Implementation of the GdNCap::PhysicsTableCache class
+
+#include "PhysicsTableCache.hh"
+#include "RunSummary.hh"
+
+#include "G4StateManager.hh"
+#include "G4VUserPhysicsList.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Version.hh"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
+
+namespace
+{
+  const char* const kFingerprintFile = "fingerprint.txt";
+
+  // FNV-1a, enough to name the directory; the full fingerprint is
+  // compared when retrieving
+  std::uint64_t Hash(const std::string& text)
+  {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsTableCache::PhysicsTableCache(const G4String& directory,
+                                     const G4String& physicsListName,
+                                     G4VUserPhysicsList* physicsList)
+: fDirectory(directory), fPhysicsListName(physicsListName), fPhysicsList(physicsList)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhysicsTableCache::Notify(G4ApplicationState requestedState)
+{
+  // Called before the change, the current state is still the old one.
+  // beamOn goes Idle -> Init (tables built) -> Idle -> GeomClosed
+  const G4ApplicationState state = G4StateManager::GetStateManager()->GetCurrentState();
+
+  if (state == G4State_Init && requestedState == G4State_Idle) {
+    fInitialized = true;
+  }
+  else if (state == G4State_Idle && requestedState == G4State_Init
+           && fInitialized && !fPrepared) {
+    Prepare();
+  }
+  else if (state == G4State_Idle && requestedState == G4State_GeomClosed
+           && fPrepared && !fRetrieved && !fStored) {
+    Store();
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PhysicsTableCache::GetFingerprint() const
+{
+  std::ostringstream os;
+  os << std::setprecision(10)
+     << "geant4 " << G4VERSION_NUMBER << '\n'
+     << "physicsList " << fPhysicsListName << '\n'
+     << "defaultCut " << fPhysicsList->GetDefaultCutValue() / mm << '\n';
+
+  // Materials in use, by name so that the order of construction and
+  // materials only listed in the table do not matter
+  std::set<const G4Material*> materials;
+  for (auto volume : *G4LogicalVolumeStore::GetInstance()) {
+    if (volume->GetMaterial()) materials.insert(volume->GetMaterial());
+  }
+  std::set<std::string> descriptions;
+  for (auto material : materials) {
+    std::ostringstream ms;
+    ms << std::setprecision(10)
+       << "material " << material->GetName()
+       << " density " << material->GetDensity() / (g/cm3)
+       << " state " << material->GetState()
+       << " temperature " << material->GetTemperature() / kelvin
+       << " pressure " << material->GetPressure() / atmosphere << '\n';
+    const G4double* fractions = material->GetFractionVector();
+    for (std::size_t i = 0; i < material->GetNumberOfElements(); ++i) {
+      const G4Element* element = material->GetElement(i);
+      ms << "  element " << element->GetName() << " Z " << element->GetZ()
+         << " fraction " << fractions[i] << '\n';
+      const G4double* abundances = element->GetRelativeAbundanceVector();
+      for (std::size_t j = 0; j < element->GetNumberOfIsotopes(); ++j) {
+        const G4Isotope* isotope = element->GetIsotope(j);
+        ms << "    isotope Z " << isotope->GetZ() << " N " << isotope->GetN()
+           << " abundance " << abundances[j] << '\n';
+      }
+    }
+    descriptions.insert(ms.str());
+  }
+  for (const auto& description : descriptions) os << description;
+
+  for (auto region : *G4RegionStore::GetInstance()) {
+    os << "region " << region->GetName();
+    if (auto cuts = region->GetProductionCuts()) {
+      for (G4int index = 0; index < 4; ++index) {
+        os << ' ' << cuts->GetProductionCut(index) / mm;
+      }
+    }
+    os << '\n';
+  }
+  return os.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::Prepare()
+{
+  fPrepared = true;
+  fFingerprint = GetFingerprint();
+  std::ostringstream name;
+  name << fPhysicsListName << '-' << std::hex << std::setw(16) << std::setfill('0')
+       << Hash(fFingerprint);
+  fTableDirectory = (std::filesystem::path(fDirectory.c_str()) / name.str()).string();
+
+  std::error_code error;
+  if (!std::filesystem::is_directory(fTableDirectory.c_str(), error)) {
+    G4cout << " Physics tables: not cached, to be stored in " << fTableDirectory << G4endl;
+    return;
+  }
+
+  std::ifstream file(fTableDirectory + "/" + kFingerprintFile);
+  const std::string stored((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+  if (stored != fFingerprint) {
+    G4ExceptionDescription msg;
+    msg << "The physics tables in " << fTableDirectory
+        << " are of another job, they are built instead.";
+    G4Exception("PhysicsTableCache::Prepare()", "MyCode0011", JustWarning, msg);
+    fStored = true;
+    return;
+  }
+
+  fPhysicsList->SetPhysicsTableRetrieved(fTableDirectory);
+  fRetrieved = true;
+  G4cout << " Physics tables: retrieved from " << fTableDirectory << G4endl;
+  RunSummary::Instance()->AddEntry("physicsTableCache", "retrieved " + fTableDirectory);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::Store()
+{
+  namespace fs = std::filesystem;
+  fStored = true;
+
+  G4Timer timer;
+  timer.Start();
+  const fs::path target(fTableDirectory.c_str());
+  fs::path temporary = target;
+  temporary += ".tmp" + std::to_string(std::random_device()());
+
+  std::error_code error;
+  fs::create_directories(temporary, error);
+  G4bool stored = !error && fPhysicsList->StorePhysicsTable(temporary.string());
+  if (stored) {
+    std::ofstream(temporary / kFingerprintFile) << fFingerprint;
+    // Fails if another job was first, its tables are as good
+    fs::rename(temporary, target, error);
+    stored = !error;
+  }
+  if (!stored) fs::remove_all(temporary, error);
+  timer.Stop();
+
+  if (stored) {
+    G4cout << " Physics tables: stored in " << fTableDirectory
+           << " in " << timer.GetRealElapsed() << " s" << G4endl;
+    RunSummary::Instance()->AddEntry("physicsTableCache", "stored " + fTableDirectory);
+  }
+  else {
+    G4cout << " Physics tables: not stored in " << fTableDirectory << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -28,10 +28,12 @@
 /// \brief Implementation of the GdNCap::PrimaryGeneratorAction class
 
 #include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
 
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Box.hh"
+#include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
@@ -56,7 +58,7 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
     = particleTable->FindParticle(particleName="neutron");
   fParticleGun->SetParticleDefinition(particle);
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
-  fParticleGun->SetParticleEnergy(0.0253 * eV);
+  fParticleGun->SetParticleEnergy(kDefaultEnergy);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -80,8 +82,12 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   G4double envSizeXY = 0;
   G4double envSizeZ = 0;
 
-  if (!fEnvelopeBox)
+  // The envelope is rebuilt by /run/reinitializeGeometry between runs
+  G4int runId = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+  if (!fEnvelopeBox || runId != fEnvelopeRunId)
   {
+    fEnvelopeBox = nullptr;
+    fEnvelopeRunId = runId;
     G4LogicalVolume* envLV
       = G4LogicalVolumeStore::GetInstance()->GetVolume("Envelope");
     if ( envLV ) fEnvelopeBox = dynamic_cast<G4Box*>(envLV->GetSolid());
@@ -100,13 +106,53 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
      "MyCode0002",JustWarning,msg);
   }
 
-  G4double size = 0.8;
-  G4double x0 = size * envSizeXY * (G4UniformRand()-0.5);
-  G4double y0 = size * envSizeXY * (G4UniformRand()-0.5);
+  const PrimarySource::Sample& sample = fSource.Next();
+  G4double size = (fSource.GetSize() > 0.) ? fSource.GetSize() : 0.8 * envSizeXY;
+  G4double x0 = size * sample.fX;
+  G4double y0 = size * sample.fY;
   G4double z0 = -0.5 * envSizeZ;
 
+  // Replayed cascades start inside the envelope, as the captures would
+  if (const CascadeLibrary* library = RunAction::GetReplayLibrary()) {
+    z0 = envSizeZ * (G4UniformRand()-0.5);
+    fCascadeGenerator.SetLibrary(library);
+    fCascadeGenerator.SetParticlePosition(G4ThreeVector(x0,y0,z0));
+    fCascadeGenerator.GeneratePrimaryVertex(anEvent);
+    return;
+  }
+
   fParticleGun->SetParticlePosition(G4ThreeVector(x0,y0,z0));
 
+  // The gun settings are stashed unless they still hold the last sampled
+  // values; a /gun/energy or /gun/direction while the source samples them
+  // is then the setting restored when it stops
+  const G4double gunEnergy = fParticleGun->GetParticleEnergy();
+  if (!fEnergySampled || gunEnergy != fSampledEnergy) fGunEnergy = gunEnergy;
+  if (fSource.GetSpectrum() != PrimarySource::Spectrum::Mono) {
+    fEnergySampled = true;
+    fParticleGun->SetParticleEnergy(sample.fEnergy);
+    fSampledEnergy = fParticleGun->GetParticleEnergy();
+  }
+  else if (fEnergySampled) {
+    fEnergySampled = false;
+    fParticleGun->SetParticleEnergy(fGunEnergy);
+  }
+
+  const G4ThreeVector gunDirection = fParticleGun->GetParticleMomentumDirection();
+  if (!fDirectionSampled || gunDirection != fSampledDirection) fGunDirection = gunDirection;
+  if (fSource.GetAngular() != PrimarySource::Angular::Beam) {
+    fDirectionSampled = true;
+    G4ThreeVector direction = sample.fDirection;
+    direction.rotateUz(fGunDirection);
+    fParticleGun->SetParticleMomentumDirection(direction);
+    // As stored, normalised, by the gun
+    fSampledDirection = fParticleGun->GetParticleMomentumDirection();
+  }
+  else if (fDirectionSampled) {
+    fDirectionSampled = false;
+    fParticleGun->SetParticleMomentumDirection(fGunDirection);
+  }
+
   fParticleGun->GeneratePrimaryVertex(anEvent);
 }
 
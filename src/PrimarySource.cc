@@ -0,0 +1,285 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/src/PrimarySource.cc
+/// \brief Implementation of the GdNCap::PrimarySource class
+
+#include "PrimarySource.hh"
+#include "PrimarySourceMessenger.hh"
+
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimarySource::PrimarySource()
+: fTemperature(0.0253 * eV)
+{
+  fMessenger = new PrimarySourceMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimarySource::~PrimarySource()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimarySource::SetSpectrum(Spectrum spectrum)
+{
+  if (spectrum == Spectrum::Table && fTable.IsEmpty()) {
+    G4Exception("PrimarySource::SetSpectrum()", "MyCode0016", JustWarning,
+      "No energy table was read, see /GdNCap/source/table.");
+    return;
+  }
+  fSpectrum = spectrum;
+  Reset();
+}
+
+void PrimarySource::SetTemperature(G4double kT)
+{
+  fTemperature = kT;
+  Reset();
+}
+
+void PrimarySource::SetProfile(Profile profile)
+{
+  fProfile = profile;
+  Reset();
+}
+
+void PrimarySource::SetAngular(Angular angular)
+{
+  fAngular = angular;
+  Reset();
+}
+
+void PrimarySource::SetDivergence(G4double halfAngle)
+{
+  fCosDivergence = std::cos(halfAngle);
+  Reset();
+}
+
+void PrimarySource::SetBatchSize(G4int batchSize)
+{
+  fBatchSize = std::max(batchSize, 1);
+  Reset();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PrimarySource::ReadTable(const G4String& fileName, G4double unit)
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open the energy table " << fileName << ".";
+    G4Exception("PrimarySource::ReadTable()", "MyCode0016", JustWarning, msg);
+    return false;
+  }
+
+  std::vector<G4double> lowEdges, widths, logRatios, contents;
+  std::string line;
+  G4int lineNumber = 0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    line = line.substr(0, line.find('#'));
+    if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+    std::istringstream is(line);
+    G4double low = 0., high = 0., content = 0.;
+    if (!(is >> low >> high >> content) || low < 0. || high <= low || content < 0.) {
+      G4ExceptionDescription msg;
+      msg << "Line " << lineNumber << " of the energy table " << fileName
+          << " is not \"<low edge> <high edge> <content>\" with 0 <= low < high"
+          << " and content >= 0.";
+      G4Exception("PrimarySource::ReadTable()", "MyCode0016", JustWarning, msg);
+      return false;
+    }
+    lowEdges.push_back(low * unit);
+    widths.push_back((high - low) * unit);
+    // Equal lethargy within a bin, as in the group structures of reactor
+    // spectra; linear in E in a bin starting at 0
+    logRatios.push_back(low > 0. ? std::log(high / low) : 0.);
+    contents.push_back(content);
+  }
+
+  AliasTable table;
+  if (!table.Build(contents)) {
+    G4ExceptionDescription msg;
+    msg << "The energy table " << fileName << " has no bin of positive content.";
+    G4Exception("PrimarySource::ReadTable()", "MyCode0016", JustWarning, msg);
+    return false;
+  }
+
+  fTable = std::move(table);
+  fLowEdges = std::move(lowEdges);
+  fWidths = std::move(widths);
+  fLogRatios = std::move(logRatios);
+  fSpectrum = Spectrum::Table;
+  Reset();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimarySource::Fill()
+{
+  // Uniform numbers per event of each quantity
+  const std::size_t nofEnergy =
+    (fSpectrum == Spectrum::Mono) ? 0 : (fSpectrum == Spectrum::Maxwellian) ? 3 : 2;
+  const std::size_t nofPosition = (fProfile == Profile::Point) ? 0 : 2;
+  const std::size_t nofDirection = (fAngular == Angular::Beam) ? 0 : 2;
+
+  const std::size_t n = fBatchSize;
+  fRandoms.resize(n * (nofEnergy + nofPosition + nofDirection));
+  if (!fRandoms.empty()) {
+    G4Random::getTheEngine()->flatArray(G4int(fRandoms.size()), fRandoms.data());
+  }
+  fSamples.resize(n);
+  fNext = 0;
+
+  const G4double* randoms = fRandoms.data();
+  FillEnergies(randoms);
+  randoms += n * nofEnergy;
+  FillPositions(randoms);
+  randoms += n * nofPosition;
+  FillDirections(randoms);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimarySource::FillEnergies(const G4double* r)
+{
+  const std::size_t n = fSamples.size();
+  switch (fSpectrum) {
+    case Spectrum::Mono:
+      break;
+
+    case Spectrum::Maxwellian:
+      // sqrt(E) exp(-E/kT) is a gamma distribution of shape 3/2: an
+      // exponential plus half the square of a normal number
+      for (std::size_t i = 0; i < n; ++i) {
+        const G4double c = std::cos(halfpi * r[3 * i + 2]);
+        fSamples[i].fEnergy =
+          -fTemperature * (std::log(r[3 * i]) + std::log(r[3 * i + 1]) * c * c);
+      }
+      break;
+
+    case Spectrum::MaxwellianFlux:
+      // E exp(-E/kT), of shape 2: the sum of two exponentials
+      for (std::size_t i = 0; i < n; ++i) {
+        fSamples[i].fEnergy = -fTemperature * std::log(r[2 * i] * r[2 * i + 1]);
+      }
+      break;
+
+    case Spectrum::Table:
+      for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t bin = fTable.Sample(r[2 * i]);
+        const G4double u = r[2 * i + 1];
+        fSamples[i].fEnergy = (fLogRatios[bin] > 0.)
+          ? fLowEdges[bin] * std::exp(u * fLogRatios[bin])
+          : fLowEdges[bin] + u * fWidths[bin];
+      }
+      break;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimarySource::FillPositions(const G4double* r)
+{
+  const std::size_t n = fSamples.size();
+  switch (fProfile) {
+    case Profile::Uniform:
+      for (std::size_t i = 0; i < n; ++i) {
+        fSamples[i].fX = r[2 * i] - 0.5;
+        fSamples[i].fY = r[2 * i + 1] - 0.5;
+      }
+      break;
+
+    case Profile::Disc:
+      for (std::size_t i = 0; i < n; ++i) {
+        const G4double rho = 0.5 * std::sqrt(r[2 * i]);
+        const G4double phi = twopi * r[2 * i + 1];
+        fSamples[i].fX = rho * std::cos(phi);
+        fSamples[i].fY = rho * std::sin(phi);
+      }
+      break;
+
+    case Profile::Gauss: {
+      // Box-Muller, with the sigma of a FWHM of 1
+      const G4double sigma = 1. / (2. * std::sqrt(2. * std::log(2.)));
+      for (std::size_t i = 0; i < n; ++i) {
+        const G4double rho = sigma * std::sqrt(-2. * std::log(r[2 * i]));
+        const G4double phi = twopi * r[2 * i + 1];
+        fSamples[i].fX = rho * std::cos(phi);
+        fSamples[i].fY = rho * std::sin(phi);
+      }
+      break;
+    }
+
+    case Profile::Point:
+      for (auto& sample : fSamples) sample.fX = sample.fY = 0.;
+      break;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimarySource::FillDirections(const G4double* r)
+{
+  if (fAngular == Angular::Beam) return;
+
+  const std::size_t n = fSamples.size();
+  const G4bool cone = (fAngular == Angular::Cone);
+  for (std::size_t i = 0; i < n; ++i) {
+    // Uniform in solid angle within the cone; the cosine law has a
+    // uniform cos^2(theta)
+    const G4double cosTheta =
+      cone ? 1. - r[2 * i] * (1. - fCosDivergence) : std::sqrt(r[2 * i]);
+    const G4double sinTheta = std::sqrt(std::max(0., 1. - cosTheta * cosTheta));
+    const G4double phi = twopi * r[2 * i + 1];
+    fSamples[i].fDirection =
+      G4ThreeVector(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
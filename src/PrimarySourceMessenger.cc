@@ -0,0 +1,196 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/src/PrimarySourceMessenger.cc
+/// \brief Implementation of the GdNCap::PrimarySourceMessenger class
+
+#include "PrimarySourceMessenger.hh"
+#include "PrimarySource.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+#include <sstream>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimarySourceMessenger::PrimarySourceMessenger(PrimarySource* source)
+: fSource(source)
+{
+  fDirectory = new G4UIdirectory("/GdNCap/source/");
+  fDirectory->SetGuidance("Energy spectrum, spatial and angular profile of the primaries");
+
+  fSpectrumCmd = new G4UIcmdWithAString("/GdNCap/source/spectrum", this);
+  fSpectrumCmd->SetGuidance("Energy spectrum of the primaries:");
+  fSpectrumCmd->SetGuidance("  mono           - the gun energy, /gun/energy (default)");
+  fSpectrumCmd->SetGuidance("  maxwellian     - sqrt(E) exp(-E/kT), neutrons in equilibrium");
+  fSpectrumCmd->SetGuidance("  maxwellianFlux - E exp(-E/kT), the flux of a thermal beam");
+  fSpectrumCmd->SetGuidance("  table          - the histogram of /GdNCap/source/table");
+  fSpectrumCmd->SetParameterName("spectrum", false);
+  fSpectrumCmd->SetCandidates("mono maxwellian maxwellianFlux table");
+  fSpectrumCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fTemperatureCmd = new G4UIcmdWithADoubleAndUnit("/GdNCap/source/kT", this);
+  fTemperatureCmd->SetGuidance("Temperature of the Maxwellian spectra (default: 25.3 meV).");
+  fTemperatureCmd->SetParameterName("kT", false);
+  fTemperatureCmd->SetUnitCategory("Energy");
+  fTemperatureCmd->SetDefaultUnit("eV");
+  fTemperatureCmd->SetRange("kT > 0.");
+  fTemperatureCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fTableCmd = new G4UIcommand("/GdNCap/source/table", this);
+  fTableCmd->SetGuidance("Read an energy histogram and select it as spectrum. One bin per");
+  fTableCmd->SetGuidance("line: <low edge> <high edge> <content>, the content being the");
+  fTableCmd->SetGuidance("probability of the bin, e.g. a group flux; '#' starts a comment.");
+  fTableCmd->SetGuidance("Within a bin the energy is uniform in ln E.");
+  fTableCmd->SetParameter(new G4UIparameter("fileName", 's', false));
+  auto unitParam = new G4UIparameter("unit", 's', true);
+  unitParam->SetGuidance("Unit of the bin edges.");
+  unitParam->SetDefaultValue("eV");
+  fTableCmd->SetParameter(unitParam);
+  fTableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fProfileCmd = new G4UIcmdWithAString("/GdNCap/source/profile", this);
+  fProfileCmd->SetGuidance("Position of the primaries on the upstream face:");
+  fProfileCmd->SetGuidance("  uniform - over a square (default)");
+  fProfileCmd->SetGuidance("  disc    - uniform over a disc");
+  fProfileCmd->SetGuidance("  gauss   - Gaussian spot");
+  fProfileCmd->SetGuidance("  point   - on the axis");
+  fProfileCmd->SetParameterName("profile", false);
+  fProfileCmd->SetCandidates("uniform disc gauss point");
+  fProfileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSizeCmd = new G4UIcmdWithADoubleAndUnit("/GdNCap/source/size", this);
+  fSizeCmd->SetGuidance("Side of the square, diameter of the disc or FWHM of the spot;");
+  fSizeCmd->SetGuidance("0 for 80% of the envelope width (default).");
+  fSizeCmd->SetParameterName("size", false);
+  fSizeCmd->SetUnitCategory("Length");
+  fSizeCmd->SetDefaultUnit("mm");
+  fSizeCmd->SetRange("size >= 0.");
+  fSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fDirectionCmd = new G4UIcmdWithAString("/GdNCap/source/direction", this);
+  fDirectionCmd->SetGuidance("Direction of the primaries:");
+  fDirectionCmd->SetGuidance("  beam   - the gun direction, /gun/direction (default)");
+  fDirectionCmd->SetGuidance("  cone   - uniform within the divergence around it");
+  fDirectionCmd->SetGuidance("  cosine - cosine law around it, as an isotropic flux");
+  fDirectionCmd->SetGuidance("           crossing the upstream face");
+  fDirectionCmd->SetParameterName("direction", false);
+  fDirectionCmd->SetCandidates("beam cone cosine");
+  fDirectionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fDivergenceCmd = new G4UIcmdWithADoubleAndUnit("/GdNCap/source/divergence", this);
+  fDivergenceCmd->SetGuidance("Half-angle of the cone direction (default: 0).");
+  fDivergenceCmd->SetParameterName("halfAngle", false);
+  fDivergenceCmd->SetUnitCategory("Angle");
+  fDivergenceCmd->SetDefaultUnit("deg");
+  fDivergenceCmd->SetRange("halfAngle >= 0.");
+  fDivergenceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBatchSizeCmd = new G4UIcmdWithAnInteger("/GdNCap/source/batchSize", this);
+  fBatchSizeCmd->SetGuidance("Number of events whose primaries are drawn at once (default: 1).");
+  fBatchSizeCmd->SetGuidance("Above 1 the primaries of an event do not come from its own");
+  fBatchSizeCmd->SetGuidance("seeds: multi-threaded runs are no longer reproducible.");
+  fBatchSizeCmd->SetParameterName("events", false);
+  fBatchSizeCmd->SetRange("events > 0");
+  fBatchSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimarySourceMessenger::~PrimarySourceMessenger()
+{
+  delete fBatchSizeCmd;
+  delete fDivergenceCmd;
+  delete fDirectionCmd;
+  delete fSizeCmd;
+  delete fProfileCmd;
+  delete fTableCmd;
+  delete fTemperatureCmd;
+  delete fSpectrumCmd;
+  delete fDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimarySourceMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fSpectrumCmd) {
+    using Spectrum = PrimarySource::Spectrum;
+    if (newValue == "maxwellian") fSource->SetSpectrum(Spectrum::Maxwellian);
+    else if (newValue == "maxwellianFlux") fSource->SetSpectrum(Spectrum::MaxwellianFlux);
+    else if (newValue == "table") fSource->SetSpectrum(Spectrum::Table);
+    else fSource->SetSpectrum(Spectrum::Mono);
+  }
+  else if (command == fTemperatureCmd) {
+    fSource->SetTemperature(fTemperatureCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fTableCmd) {
+    std::istringstream is(newValue);
+    G4String fileName, unit;
+    is >> fileName >> unit;
+    if (G4UIcommand::CategoryOf(unit) != "Energy") {
+      G4ExceptionDescription msg;
+      msg << "\"" << unit << "\" is not a unit of energy.";
+      G4Exception("PrimarySourceMessenger::SetNewValue()", "MyCode0016", JustWarning, msg);
+      return;
+    }
+    fSource->ReadTable(fileName, G4UIcommand::ValueOf(unit));
+  }
+  else if (command == fProfileCmd) {
+    using Profile = PrimarySource::Profile;
+    if (newValue == "disc") fSource->SetProfile(Profile::Disc);
+    else if (newValue == "gauss") fSource->SetProfile(Profile::Gauss);
+    else if (newValue == "point") fSource->SetProfile(Profile::Point);
+    else fSource->SetProfile(Profile::Uniform);
+  }
+  else if (command == fSizeCmd) {
+    fSource->SetSize(fSizeCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fDirectionCmd) {
+    using Angular = PrimarySource::Angular;
+    if (newValue == "cone") fSource->SetAngular(Angular::Cone);
+    else if (newValue == "cosine") fSource->SetAngular(Angular::Cosine);
+    else fSource->SetAngular(Angular::Beam);
+  }
+  else if (command == fDivergenceCmd) {
+    fSource->SetDivergence(fDivergenceCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fBatchSizeCmd) {
+    fSource->SetBatchSize(fBatchSizeCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
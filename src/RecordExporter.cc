@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/RecordExporter.cc
+/// \brief Implementation of the GdNCap::RecordExporter class
+
+#include "RecordExporter.hh"
+
+#include "G4Threading.hh"
+#include "G4Timer.hh"
+
+#include <array>
+#include <filesystem>
+#include <future>
+#include <thread>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RecordExporter::RecordExporter(G4int nofThreads)
+: fNofThreads(nofThreads > 0 ? nofThreads : G4Threading::G4GetNumberOfCores())
+{
+  if (fNofThreads < 1) fNofThreads = 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RecordExporter::Export(const CaptureRecordView& view, VRecordWriter& writer,
+                            const G4String& suffix)
+{
+  G4Timer timer;
+  timer.Start();
+
+  writer.Open(suffix);
+  if (writer.CanFormatChunks() && fNofThreads > 1) WriteChunks(view, writer);
+  else writer.Write(view);
+  writer.Close();
+
+  timer.Stop();
+  fRealElapsed = timer.GetRealElapsed();
+
+  fNofBytes = 0;
+  for (const auto& fileName : writer.GetFileNames(suffix)) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(fileName.c_str(), error);
+    if (!error) fNofBytes += size;
+  }
+
+  G4double megabytes = fNofBytes / (1024. * 1024.);
+  G4cout
+    << G4endl
+    << " Wrote " << writer.GetNumberOfEvents() << " capture records, "
+    << megabytes << " MB in " << fRealElapsed << " s";
+  if (fRealElapsed > 0.) G4cout << " (" << megabytes / fRealElapsed << " MB/s)";
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RecordExporter::WriteChunks(const CaptureRecordView& view,
+                                 VRecordWriter& writer) const
+{
+  const std::size_t nofRanges = fNofThreads;
+  std::vector<std::vector<CaptureRecordView::Event>> ranges(nofRanges);
+  for (auto& range : ranges) range.reserve(kEventsPerChunk);
+
+  // Two sets of chunks: one is formatted while the other is written
+  std::array<std::vector<VRecordWriter::Chunk>, 2> chunks;
+  for (auto& chunkSet : chunks) chunkSet.resize(nofRanges);
+  std::future<void> writing;
+
+  CaptureRecordView::Cursor cursor(view);
+  CaptureRecordView::Event event;
+  for (std::size_t round = 0; ; ++round) {
+    // Ranges of consecutive events, the cursor is not thread-safe
+    std::size_t nofFilled = 0;
+    for (auto& range : ranges) {
+      range.clear();
+      while (range.size() < kEventsPerChunk && cursor.Next(event)) range.push_back(event);
+      if (range.empty()) break;
+      ++nofFilled;
+    }
+    if (nofFilled == 0) break;
+
+    auto& current = chunks[round % 2];
+    std::vector<std::thread> formatters;
+    for (std::size_t i = 1; i < nofFilled; ++i) {
+      formatters.emplace_back(
+        [&writer, &ranges, &current, i] { writer.FormatChunk(ranges[i], current[i]); });
+    }
+    writer.FormatChunk(ranges[0], current[0]);
+    for (auto& formatter : formatters) formatter.join();
+
+    // Chunks are written in order, one round at a time
+    if (writing.valid()) writing.get();
+    writing = std::async(std::launch::async, [&writer, &current, nofFilled] {
+      for (std::size_t i = 0; i < nofFilled; ++i) writer.WriteChunk(current[i]);
+    });
+  }
+  if (writing.valid()) writing.get();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,105 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/RecordQueue.cc
+/// \brief Implementation of the GdNCap::RecordQueue class
+
+#include "RecordQueue.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RecordQueue::RecordQueue(std::size_t capacity)
+{
+  std::size_t size = 2;
+  while (size < capacity) size <<= 1;
+  fMask = size - 1;
+  fCells.reset(new Cell[size]);
+  for (std::size_t pos = 0; pos < size; ++pos) {
+    fCells[pos].fSequence.store(pos, std::memory_order_relaxed);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool RecordQueue::TryPush(G4int producer, G4int eventId, G4double edep,
+                            G4double totalEnergy,
+                            const std::vector<G4double>& energies,
+                            const std::vector<TypeId>& types,
+                            const std::vector<G4double>& weights)
+{
+  Cell* cell = nullptr;
+  std::size_t pos = fEnqueuePos.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &fCells[pos & fMask];
+    std::size_t sequence = cell->fSequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+    if (difference == 0) {
+      // The cell is free, claim the position
+      if (fEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    }
+    else if (difference < 0) {
+      // The consumer has not released this cell since the last lap: full
+      return false;
+    }
+    else {
+      pos = fEnqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  Record& record = cell->fRecord;
+  record.fProducer = producer;
+  record.fEventId = eventId;
+  record.fEdep = edep;
+  record.fTotalEnergy = totalEnergy;
+  record.fEnergies.assign(energies.begin(), energies.end());
+  record.fTypes.assign(types.begin(), types.end());
+  record.fWeights.assign(weights.begin(), weights.end());
+
+  cell->fSequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool RecordQueue::TryPop(Record& record)
+{
+  Cell& cell = fCells[fDequeuePos & fMask];
+  if (cell.fSequence.load(std::memory_order_acquire) != fDequeuePos + 1) return false;
+
+  std::swap(record, cell.fRecord);
+
+  // Free the cell for the producers of the next lap
+  cell.fSequence.store(fDequeuePos + fMask + 1, std::memory_order_release);
+  ++fDequeuePos;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,89 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+/// \file GdNCap/src/RouletteOperation.cc
+/// \brief Implementation of the GdNCap::RouletteOperation class
+
+#include "RouletteOperation.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+
+#include <cfloat>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RouletteOperation::RouletteOperation(const G4String& name)
+: G4VBiasingOperation(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double RouletteOperation::DistanceToApplyOperation(const G4Track*, G4double,
+                                                     G4ForceCondition* condition)
+{
+  // Applied at the end of the step, whatever limits it
+  *condition = Forced;
+  return DBL_MAX;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VParticleChange* RouletteOperation::GenerateBiasingFinalState(const G4Track* track,
+                                                                const G4Step*)
+{
+  // The track already carries the weight of the along-step biasing
+  fParticleChange.Initialize(*track);
+  const G4double weight = track->GetWeight();
+  fTrack = track;
+  fStepNumber = track->GetCurrentStepNumber();
+  fWeightBefore = weight;
+  if (weight >= fThreshold) return &fParticleChange;
+
+  if (G4UniformRand() * fSurvival < weight) {
+    fParticleChange.ProposeWeight(fSurvival);
+  }
+  else {
+    fParticleChange.ProposeTrackStatus(fStopAndKill);
+  }
+  return &fParticleChange;
+}
+
+G4double RouletteOperation::GetWeightBeforeRoulette(const G4Step* step) const
+{
+  const G4Track* track = step->GetTrack();
+  if (track == fTrack && track->GetCurrentStepNumber() == fStepNumber) return fWeightBefore;
+  return step->GetPostStepPoint()->GetWeight();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
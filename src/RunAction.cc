@@ -28,6 +28,14 @@
 /// \brief Implementation of the GdNCap::RunAction class
 
 #include "RunAction.hh"
+#include "RunMessenger.hh"
+#include "BinaryRecordWriter.hh"
+#include "IndexedRecordWriter.hh"
+#include "MemoryMonitor.hh"
+#include "RecordExporter.hh"
+#include "RunSummary.hh"
+#include "StartupMonitor.hh"
+#include "TextRecordWriter.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "DetectorConstruction.hh"
 // #include "Run.hh"
@@ -35,10 +43,14 @@
 #include "G4RunManager.hh"
 #include "G4Run.hh"
 #include "G4AccumulableManager.hh"
+#include "G4AutoLock.hh"
+#include "G4AnalysisManager.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4Timer.hh"
 
 #include "G4HadronicInteraction.hh"
 #include "G4HadronicInteractionRegistry.hh"
@@ -46,11 +58,24 @@
 #include "G4AblaInterface.hh"
 #include "G4INCLXXInterfaceStore.hh"
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+namespace
+{
+  G4Mutex mergeTimeMutex = G4MUTEX_INITIALIZER;
+}
 
 namespace GdNCap
 {
 
+AsyncRecordWriter* RunAction::fgAsyncWriter = nullptr;
+SharedMemorySink* RunAction::fgSharedMemorySink = nullptr;
+const CascadeLibrary* RunAction::fgReplayLibrary = nullptr;
+G4double RunAction::fgMergeTime = 0.;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 RunAction::RunAction()
@@ -68,23 +93,84 @@ RunAction::RunAction()
   new G4UnitDefinition("picogray" , "picoGy"  , "Dose", picogray);
 
   fSecondaries = new Accumulable();
+  fShardManifest = new ShardManifest();
+  fRunConditions = new RunConditions();
+  fWorkerTelemetry = new WorkerTelemetry();
+  fCascadeLibrary = new CascadeLibrary();
+
+  // Capture spectra, energies in MeV
+  using Binning = H1Accumulable::Binning;
+  fHistos[kGammaEnergyH] = new H1Accumulable("gammaEnergy", 1000, 0., 10., Binning::Linear);
+  fHistos[kCaptureEnergyH] = new H1Accumulable("captureEnergy", 1000, 0., 10., Binning::Linear);
+  fHistos[kMultiplicityH] = new H1Accumulable("multiplicity", 30, -0.5, 29.5, Binning::Linear);
+  fHistos[kEdepH] = new H1Accumulable("edep", 1000, 0., 10., Binning::Linear);
+  // Weighted capture depth behind the upstream face, in mm
+  fHistos[kCaptureDepthH] = new H1Accumulable("captureDepth", 100, 0., 10., Binning::Linear);
+  // Wall and CPU time per event, in us, 20 bins per decade up to 100 s
+  fHistos[kEventTimeH] = new H1Accumulable("eventTime", 160, 1., 1.e8, Binning::Log);
+  fHistos[kEventCpuTimeH] = new H1Accumulable("eventCpuTime", 160, 1., 1.e8, Binning::Log);
 
   // Register accumulable to the accumulable manager
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->RegisterAccumulable(fEdep);
   accumulableManager->RegisterAccumulable(fEdep2);
+  accumulableManager->RegisterAccumulable(fNofSteps);
+  accumulableManager->RegisterAccumulable(fNofCaptures);
+  accumulableManager->RegisterAccumulable(fCaptureYield);
+  accumulableManager->RegisterAccumulable(fCaptureYield2);
+  accumulableManager->RegisterAccumulable(fTransmission);
+  accumulableManager->RegisterAccumulable(fTransmission2);
   accumulableManager->RegisterAccumulable(fSecondaries);
+  accumulableManager->RegisterAccumulable(fShardManifest);
+  accumulableManager->RegisterAccumulable(fRunConditions);
+  accumulableManager->RegisterAccumulable(fWorkerTelemetry);
+  accumulableManager->RegisterAccumulable(fCascadeLibrary);
+  for (auto histo : fHistos) accumulableManager->RegisterAccumulable(histo);
   //G4RunManager::GetRunManager()->SetPrintProgress(10);
+
+  // Book the ntuples of the analysis output mode; the file type is
+  // only chosen when the file is opened
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetVerboseLevel(0);
+  fEventNtupleId = analysisManager->CreateNtuple("Events", "Capture events, energies in MeV");
+  analysisManager->CreateNtupleIColumn("eventID");
+  analysisManager->CreateNtupleDColumn("edep");
+  analysisManager->CreateNtupleDColumn("totalEnergy");
+  analysisManager->CreateNtupleIColumn("multiplicity");
+  analysisManager->FinishNtuple();
+  fSecondaryNtupleId = analysisManager->CreateNtuple("Secondaries",
+    "Capture gammas and electrons, energies in MeV");
+  analysisManager->CreateNtupleIColumn("eventID");
+  analysisManager->CreateNtupleDColumn("energy");
+  analysisManager->CreateNtupleSColumn("type");
+  analysisManager->CreateNtupleDColumn("weight");
+  analysisManager->FinishNtuple();
+
+  fMessenger = new RunMessenger(this);
+  // After the messenger, which creates the /GdNCap/ directory
+  fCaptureFilter = new CaptureFilter();
+  fStepProfiler = new StepProfiler();
+  accumulableManager->RegisterAccumulable(fStepProfiler);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 RunAction::~RunAction()
 {
+    delete fStepProfiler;
+    delete fCaptureFilter;
+    delete fMessenger;
     delete fSecondaries;
+    delete fShardManifest;
+    delete fRunConditions;
+    delete fWorkerTelemetry;
+    delete fCascadeLibrary;
+    for (auto histo : fHistos) delete histo;
+    if (fSharedMemorySink) fgSharedMemorySink = nullptr;
+    if (fReplayLibrary) fgReplayLibrary = nullptr;
 }
 
-void RunAction::BeginOfRunAction(const G4Run*)
+void RunAction::BeginOfRunAction(const G4Run* run)
 {
     // Get hold of pointers to the INCL++ model interfaces
     std::vector<G4HadronicInteraction*> interactions = 
@@ -111,25 +197,175 @@ void RunAction::BeginOfRunAction(const G4Run*)
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Reset();
 
+  // This thread's capture processes and recorded particles
+  fCaptureFilter->Resolve();
+  fTimer.Start();
+
+  // The master begins its run before the workers; on a multi-threaded
+  // master there are no events to time
+  const G4bool processesEvents = !(IsMaster() && G4Threading::IsMultithreadedApplication());
+  if (IsMaster()) {
+    fgMergeTime = 0.;
+    if (auto memoryMonitor = MemoryMonitor::Instance()) {
+      memoryMonitor->BeginRun(run->GetNumberOfEventToBeProcessed());
+    }
+  }
+  if (processesEvents) fWorkerTelemetry->Begin(std::max(G4Threading::G4GetThreadId(), 0));
+
+  // The master reads the replayed cascade library before the workers
+  // generate events, and keeps it across runs
+  if (IsMaster()) {
+    if (fReplayFile.empty()) {
+      fReplayLibrary.reset();
+      fLoadedReplayFile = "";
+    }
+    else if (fReplayFile != fLoadedReplayFile) {
+      fReplayLibrary = std::make_unique<CascadeLibrary>();
+      if (!fReplayLibrary->Read(fReplayFile)) fReplayLibrary.reset();
+      fLoadedReplayFile = fReplayFile;
+    }
+    if (fReplayLibrary && !fReplayLibrary->Select(fReplayZ, fReplayA)) {
+      G4ExceptionDescription msg;
+      msg << "No cascade of Z = " << fReplayZ << ", A = " << fReplayA << " in "
+          << fReplayFile << ", the particle gun is used instead.";
+      G4Exception("RunAction::BeginOfRunAction()", "MyCode0010", JustWarning, msg);
+      fReplayLibrary.reset();
+      fLoadedReplayFile = "";
+    }
+    fgReplayLibrary = fReplayLibrary.get();
+  }
+
+  // Record the gun settings for the master
+  //  note: There is no primary generator action object for "master"
+  //        run manager for multi-threaded mode.
+  const auto generatorAction = static_cast<const PrimaryGeneratorAction*>(
+    G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
+  if (generatorAction)
+  {
+    const G4ParticleGun* particleGun = generatorAction->GetParticleGun();
+    if (fgReplayLibrary) {
+      fRunConditions->SetPrimary("capture cascade", 0.);
+    }
+    else {
+      // No single energy for a sampled spectrum
+      const G4bool mono =
+        generatorAction->GetSource().GetSpectrum() == PrimarySource::Spectrum::Mono;
+      fRunConditions->SetPrimary(particleGun->GetParticleDefinition()->GetParticleName(),
+                                 mono ? particleGun->GetParticleEnergy() : 0.);
+    }
+  }
+
+  // The master keeps the shared-memory ring across runs, so consumers
+  // stay attached, unless its settings changed
+  if (IsMaster()) {
+    if (fSharedMemoryName.empty()) {
+      fSharedMemorySink.reset();
+    }
+    else if (!fSharedMemorySink
+             || fSharedMemorySink->GetName() != fSharedMemoryName
+             || fSharedMemorySink->GetNumberOfSlots() < std::size_t(fSharedMemorySlots)) {
+      fSharedMemorySink.reset();
+      fSharedMemorySink = std::make_unique<SharedMemorySink>(fSharedMemoryName, fSharedMemorySlots);
+    }
+    if (fSharedMemorySink) fSharedMemorySink->BeginRun();
+    fgSharedMemorySink = fSharedMemorySink.get();
+  }
+
+  // Every thread opens its ntuple file; with ROOT merging the workers'
+  // rows end up in the master's file
+  if (fOutputMode == OutputMode::Analysis) {
+    auto analysisManager = G4AnalysisManager::Instance();
+    analysisManager->SetDefaultFileType(fNtupleFileType);
+    if (fNtupleFileType == "root") analysisManager->SetNtupleMerging(fNtupleMerging);
+    analysisManager->OpenFile("CaptureNtuples" + GetOutputSuffix());
+  }
+
+  // In async mode the master starts the I/O thread before the workers
+  // begin their run, and joins it after they have ended it
+  if (fOutputMode == OutputMode::Async) {
+    if (IsMaster()) {
+      fAsyncWriter = std::make_unique<AsyncRecordWriter>(CreateRecordWriter(), fQueueCapacity);
+      fAsyncWriter->Start(G4RunManager::GetRunManager()->GetNumberOfThreads(),
+                          GetOutputSuffix());
+      fgAsyncWriter = fAsyncWriter.get();
+    }
+    fProducerId = std::max(G4Threading::G4GetThreadId(), 0);
+    if (fRunConditions->IsSet()) {
+      fgAsyncWriter->SetPrimary(fRunConditions->GetParticleName(),
+                                fRunConditions->GetEnergy() / MeV);
+    }
+  }
+
+  // In stream mode every thread processing events writes its own shard;
+  // on a multi-threaded master there is nothing to stream
+  if (fOutputMode == OutputMode::Stream && processesEvents) {
+    fShardWriter = CreateRecordWriter();
+    fShardWriter->Open(GetOutputSuffix() + "_t"
+                       + std::to_string(std::max(G4Threading::G4GetThreadId(), 0)));
+    fSecondaries->SetBlockSink(
+      [this](const CaptureRecordBlock& block) { fShardWriter->Write(block); });
+  }
+  else {
+    fSecondaries->SetBlockSink(nullptr);
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void RunAction::EndOfRunAction(const G4Run* run)
 {
+  fTimer.Stop();
+
+  // The shard has to be complete before its summary is merged
+  G4Timer writeTimer;
+  writeTimer.Start();
+  if (fShardWriter) CloseShard();
+
+  if (fOutputMode == OutputMode::Analysis) {
+    auto analysisManager = G4AnalysisManager::Instance();
+    analysisManager->Write();
+    analysisManager->CloseFile();
+  }
+  writeTimer.Stop();
+  fWorkerTelemetry->AddWriteTime(writeTimer.GetRealElapsed());
+  auto memoryMonitor = MemoryMonitor::Instance();
+  if (memoryMonitor && !(IsMaster() && G4Threading::IsMultithreadedApplication())) {
+    memoryMonitor->Sample("endOfWorkerRun");
+  }
+
+  // All workers have ended their run when the master gets here
+  if (fSharedMemorySink) fSharedMemorySink->EndRun();
+  G4double asyncTailTime = 0.;
+  if (fAsyncWriter) {
+    G4Timer timer;
+    timer.Start();
+    fAsyncWriter->Stop();
+    timer.Stop();
+    asyncTailTime = timer.GetRealElapsed();
+    fgAsyncWriter = nullptr;
+  }
+
   G4int nofEvents = run->GetNumberOfEvent();
   if (nofEvents == 0) return;
 
-  // Merge accumulables
+  // Merge accumulables; the workers merge into the master's ones
+  G4Timer mergeTimer;
+  mergeTimer.Start();
+  fStepProfiler->Flush();
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Merge();
+  mergeTimer.Stop();
+  {
+    G4AutoLock lock(&mergeTimeMutex);
+    fgMergeTime += mergeTimer.GetRealElapsed();
+  }
+  if (memoryMonitor && IsMaster()) memoryMonitor->Sample("afterMerge");
 
   // Compute dose = total energy deposit in a run and its variance
   //
   G4double edep  = fEdep.GetValue();
   G4double edep2 = fEdep2.GetValue();
-  auto secondariesList = fSecondaries->GetSecondariesList();
-  auto secondariesEnergy = fSecondaries->GetSecondariesEnergy();
+  const auto secondaries = fSecondaries->GetView();
 
   G4double rms = edep2 - edep*edep/nofEvents;
   if (rms > 0.) rms = std::sqrt(rms); else rms = 0.;
@@ -140,19 +376,16 @@ void RunAction::EndOfRunAction(const G4Run* run)
   G4double dose = edep/mass;
   G4double rmsDose = rms/mass;
 
-  // Run conditions
-  //  note: There is no primary generator action object for "master"
-  //        run manager for multi-threaded mode.
-  const auto generatorAction = static_cast<const PrimaryGeneratorAction*>(
-    G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
+  // Run conditions, merged from the workers on the master
   G4String runCondition;
-  if (generatorAction)
+  if (fRunConditions->IsSet())
   {
-    const G4ParticleGun* particleGun = generatorAction->GetParticleGun();
-    runCondition += particleGun->GetParticleDefinition()->GetParticleName();
-    runCondition += " of ";
-    G4double particleEnergy = particleGun->GetParticleEnergy();
-    runCondition += G4BestUnit(particleEnergy,"Energy");
+    runCondition += fRunConditions->GetParticleName();
+    G4double particleEnergy = fRunConditions->GetEnergy();
+    if (particleEnergy > 0.) {
+      runCondition += " of ";
+      runCondition += G4BestUnit(particleEnergy,"Energy");
+    }
   }
 
   // Print
@@ -162,40 +395,43 @@ void RunAction::EndOfRunAction(const G4Run* run)
      << G4endl
      << "--------------------End of Global Run-----------------------";
 
-    G4String totalEnergyName = "SecondaryTotalEnergy.txt";
-    G4String energyName = "SecondaryEnergy.txt";
-    G4String nameName = "SecondaryName.txt";
-    if (!secondariesList.empty())
-    {
-        std::ofstream totalEnergyFile;
-        std::ofstream energyFile;
-        std::ofstream nameFile;
-        totalEnergyFile.open(totalEnergyName, std::ios_base::out);
-        energyFile.open(energyName, std::ios_base::out);
-        nameFile.open(nameName, std::ios_base::out);
-        for (auto itr = secondariesEnergy.begin(); itr != secondariesEnergy.end(); ++itr)
-        {
-            if (*itr > 0)
-            {
-                totalEnergyFile << *itr << G4endl;
-            }            
-        }
-        totalEnergyFile.close();
-        for (auto itrVec = secondariesList.begin(); itrVec != secondariesList.end(); ++itrVec)
-        {
-            if (itrVec->size() > 0)
-            {
-                for (auto itr = itrVec->begin(); itr != itrVec->end(); ++itr)
-                {
-                    energyFile << itr->first << " ";
-                    nameFile << itr->second << " ";
-                }
-                energyFile << G4endl;
-                nameFile << G4endl;
-            }
-        }
-        energyFile.close();
-        nameFile.close();
+    writeTimer.Start();
+    if (fOutputMode == OutputMode::Stream) {
+      fShardManifest->Write("SecondaryManifest" + GetOutputSuffix() + ".txt");
+    }
+    else if (fAsyncWriter) {
+      G4cout
+        << G4endl
+        << " I/O thread wrote " << fAsyncWriter->GetWriter().GetNumberOfEvents()
+        << " capture records, " << asyncTailTime << " s after the last event;"
+        << G4endl
+        << " producers waited on a full queue " << fAsyncWriter->GetNumberOfStalls()
+        << " times, at most " << fAsyncWriter->GetMaxPending()
+        << " records were held for reordering";
+      fAsyncWriter.reset();
+    }
+    else if (fOutputMode == OutputMode::Memory && !secondaries.IsEmpty()) {
+      auto writer = CreateRecordWriter();
+      RecordExporter exporter(fWriterThreads);
+      exporter.Export(secondaries, *writer, GetOutputSuffix());
+    }
+    for (auto histo : fHistos) histo->Write("Histo_" + histo->GetName() + GetOutputSuffix() + ".txt");
+    writeTimer.Stop();
+    if (memoryMonitor) memoryMonitor->Sample("afterWrite");
+    PrintTelemetry(run->GetRunID(), fgMergeTime, writeTimer.GetRealElapsed() + asyncTailTime);
+    if (memoryMonitor) memoryMonitor->Report();
+    fStepProfiler->Report();
+    RunSummary::Instance()->AddRun(run->GetRunID(), nofEvents, fTimer.GetRealElapsed());
+    if (auto monitor = StartupMonitor::Instance()) monitor->Report();
+    if (!fCascadeBuildFile.empty() && fCascadeLibrary->Write(fCascadeBuildFile)) {
+      G4cout << G4endl << " Cascade library " << fCascadeBuildFile << ":";
+      for (const auto& isotope : fCascadeLibrary->GetIsotopes()) {
+        G4cout
+          << G4endl
+          << "   Z = " << isotope.fZ << ", A = " << isotope.fA << ": "
+          << isotope.GetNumberOfCascades() << " cascades of "
+          << isotope.fNofCaptures << " captures";
+      }
     }
   }
   else {
@@ -207,10 +443,49 @@ void RunAction::EndOfRunAction(const G4Run* run)
   G4cout
      << G4endl
      << " The run consists of " << nofEvents << " "<< runCondition
-     << G4endl
+     << G4endl;
+  if (fCaptureFilter->ScoresEdep()) {
+    G4cout
      << " Cumulated dose per run, in scoring volume : "
      << G4BestUnit(dose,"Dose") << " rms = " << G4BestUnit(rmsDose,"Dose")
-     << G4endl
+     << G4endl;
+  }
+  else {
+    G4cout
+     << " Cumulated dose per run, in scoring volume : unavailable,"
+     << " secondaries are not transported (/GdNCap/capture/transport)"
+     << G4endl;
+  }
+  G4double realElapsed = fTimer.GetRealElapsed();
+  G4cout
+     << " Capture events: " << fNofCaptures.GetValue() << " in " << realElapsed
+     << " s (" << (realElapsed > 0. ? fNofCaptures.GetValue() / realElapsed : 0.)
+     << " /s)"
+     << G4endl;
+  PrintAccumulableMemory();
+  // Steps are counted by the stepping action, not in the "sd" scoring mode
+  if (fNofSteps.GetValue() > 0) {
+    G4cout
+     << " Steps: " << fNofSteps.GetValue() << " in " << fTimer.GetRealElapsed()
+     << " s (" << (fTimer.GetRealElapsed() > 0. ? fNofSteps.GetValue() / fTimer.GetRealElapsed() : 0.)
+     << " steps/s), capture filter: "
+     << (fCaptureFilter->UsesStringMatch() ? "string match" : "pointer match")
+     << G4endl;
+  }
+
+  // Tallies per source neutron; an unbiased run is the reference of the
+  // following biased ones, for their gain and their consistency
+  const G4bool biased = detConstruction->IsBiased();
+  const Tally captureYield = GetTally(fCaptureYield.GetValue(), fCaptureYield2.GetValue(), nofEvents);
+  const Tally transmission = GetTally(fTransmission.GetValue(), fTransmission2.GetValue(), nofEvents);
+  G4cout << " Biasing: " << detConstruction->GetBiasingModeName() << G4endl;
+  PrintTally("Capture yield", captureYield, biased ? &fUnbiasedCapture : nullptr);
+  PrintTally("Transmission", transmission, biased ? &fUnbiasedTransmission : nullptr);
+  if (!biased) {
+    fUnbiasedCapture = captureYield;
+    fUnbiasedTransmission = transmission;
+  }
+  G4cout
      << "------------------------------------------------------------"
      << G4endl
      << G4endl;
@@ -224,14 +499,228 @@ void RunAction::AddEdep(G4double edep)
   fEdep2 += edep*edep;
 }
 
-void RunAction::PushSecondariesList(std::vector<std::pair<G4double, G4String>> fSecL)
+void RunAction::AddTallies(G4double captureYield, G4double transmission)
 {
-    fSecondaries->PushSecondariesList(fSecL);
+  fCaptureYield  += captureYield;
+  fCaptureYield2 += captureYield*captureYield;
+  fTransmission  += transmission;
+  fTransmission2 += transmission*transmission;
 }
 
-void RunAction::PushSecondariesEnergy(G4double fSecE)
+RunAction::Tally RunAction::GetTally(G4double sum, G4double sum2, G4int nofEvents) const
 {
-    fSecondaries->PushSecondariesEnergy(fSecE);
+  // Events are the independent histories; without a score the relative
+  // error and figure of merit are left at zero
+  Tally tally;
+  tally.fMean = sum / nofEvents;
+  if (sum <= 0.) return tally;
+  G4double variance = (sum2 / nofEvents - tally.fMean * tally.fMean) / nofEvents;
+  tally.fRelativeError = variance > 0. ? std::sqrt(variance) / tally.fMean : 0.;
+  G4double realElapsed = fTimer.GetRealElapsed();
+  if (tally.fRelativeError > 0. && realElapsed > 0.) {
+    tally.fFigureOfMerit = 1. / (tally.fRelativeError * tally.fRelativeError * realElapsed);
+  }
+  return tally;
+}
+
+void RunAction::PrintTally(const G4String& name, const Tally& tally,
+                           const Tally* unbiased) const
+{
+  G4cout
+     << " " << name << " per neutron: " << tally.fMean
+     << " R = " << tally.fRelativeError
+     << " FOM = " << tally.fFigureOfMerit << " /s";
+  if (!unbiased || unbiased->fFigureOfMerit <= 0.) {
+    G4cout << G4endl;
+    return;
+  }
+  if (tally.fFigureOfMerit > 0.) {
+    G4cout << " (gain " << tally.fFigureOfMerit / unbiased->fFigureOfMerit << ")";
+  }
+  G4cout << G4endl;
+
+  // A biasing mode has to keep the expected value of the tally
+  const G4double sigma = tally.fRelativeError * tally.fMean;
+  const G4double unbiasedSigma = unbiased->fRelativeError * unbiased->fMean;
+  const G4double deviation = (tally.fMean - unbiased->fMean)
+                             / std::sqrt(sigma * sigma + unbiasedSigma * unbiasedSigma);
+  G4cout << " " << name << " deviation from the unbiased run: " << deviation
+         << " standard deviations" << G4endl;
+  if (std::abs(deviation) > kMaxDeviation) {
+    G4ExceptionDescription msg;
+    msg << name << " " << tally.fMean << " differs from " << unbiased->fMean
+        << " of the last unbiased run by " << deviation << " standard deviations;"
+        << " unless the geometry or source changed in between, the biasing"
+        << " does not keep its expected value.";
+    G4Exception("RunAction::PrintTally()", "MyCode0011", JustWarning, msg);
+  }
+}
+
+void RunAction::PrintTelemetry(G4int runId, G4double mergeTime, G4double writeTime) const
+{
+  // The workers' writes at the end of their run are in their entries
+  const auto& workers = fWorkerTelemetry->GetWorkers();
+  if (workers.empty()) return;
+  const WorkerTelemetry::Worker* slowest = &workers.front();
+  G4long minEvents = workers.front().fNofEvents;
+  G4long maxEvents = 0;
+  G4double wallTime = 0.;
+  G4double userActionTime = 0.;
+  G4double workerWriteTime = 0.;
+  for (const auto& worker : workers) {
+    if (worker.fWallTime > slowest->fWallTime) slowest = &worker;
+    minEvents = std::min(minEvents, worker.fNofEvents);
+    maxEvents = std::max(maxEvents, worker.fNofEvents);
+    wallTime += worker.fWallTime;
+    userActionTime += worker.fUserActionTime;
+    workerWriteTime = std::max(workerWriteTime, worker.fWriteTime);
+  }
+
+  const H1Accumulable* eventTime = fHistos[kEventTimeH];
+  const H1Accumulable* eventCpuTime = fHistos[kEventCpuTimeH];
+  const G4double p50 = eventTime->GetQuantile(0.5) * microsecond;
+  const G4double p99 = eventTime->GetQuantile(0.99) * microsecond;
+  const G4double imbalance = fWorkerTelemetry->GetImbalance();
+  G4cout
+    << G4endl
+    << " Event time: p50 = " << G4BestUnit(p50, "Time")
+    << " p99 = " << G4BestUnit(p99, "Time")
+    << " (CPU p50 = " << G4BestUnit(eventCpuTime->GetQuantile(0.5) * microsecond, "Time")
+    << " p99 = " << G4BestUnit(eventCpuTime->GetQuantile(0.99) * microsecond, "Time") << ")"
+    << G4endl
+    << " Workers: " << workers.size() << ", " << minEvents << " to " << maxEvents
+    << " events each, imbalance " << imbalance
+    << " (slowest thread " << slowest->fThreadId << ": " << slowest->fWallTime
+    << " s for " << slowest->fNofEvents << " events), "
+    << (wallTime > 0. ? 100. * userActionTime / wallTime : 0.)
+    << " % of the event time in the event actions"
+    << G4endl
+    << " Merge: " << mergeTime << " s, write: " << writeTime << " s"
+    << " (workers at most " << workerWriteTime << " s)";
+
+  std::ostringstream entry;
+  entry << runId << " " << p50 / s << " " << p99 / s << " " << imbalance;
+  RunSummary::Instance()->AddEntry("eventTime", entry.str());
+}
+
+void RunAction::PrintAccumulableMemory() const
+{
+  // The master's records share the blocks of the workers, they are not copied
+  std::size_t histograms = 0;
+  for (auto histo : fHistos) histograms += histo->GetMemoryUsage();
+  const std::pair<const char*, std::size_t> accumulables[] = {
+    { "records", fSecondaries->GetMemoryUsage() },
+    { "cascades", fCascadeLibrary->GetMemoryUsage() },
+    { "histograms", histograms },
+    { "telemetry", fWorkerTelemetry->GetMemoryUsage() },
+    { "stepProfile", fStepProfiler->GetMemoryUsage() } };
+
+  std::size_t total = 0;
+  G4cout << " Accumulables:";
+  for (const auto& [name, bytes] : accumulables) {
+    G4cout << " " << name << " " << bytes / (1024. * 1024.) << " MB,";
+    total += bytes;
+  }
+  G4cout << " total " << total / (1024. * 1024.) << " MB" << G4endl;
+}
+
+void RunAction::AddEventTime(G4double wallTime, G4double cpuTime, G4double userActionTime)
+{
+  fHistos[kEventTimeH]->Fill(wallTime * s / microsecond);
+  fHistos[kEventCpuTimeH]->Fill(cpuTime * s / microsecond);
+  fWorkerTelemetry->AddEvent(wallTime, cpuTime, userActionTime);
+}
+
+void RunAction::PushSecondaries(G4int eventId, G4double edep, G4double secE,
+                                const std::vector<G4double>& secEnergy,
+                                const std::vector<ParticleTypeTable::TypeId>& secType,
+                                const std::vector<G4double>& secWeight)
+{
+    if (fgSharedMemorySink) {
+      fgSharedMemorySink->Publish(eventId, edep, secE, secEnergy, secType, secWeight);
+    }
+    if (fOutputMode == OutputMode::None || fOutputMode == OutputMode::Analysis) return;
+    if (fOutputMode == OutputMode::Async) {
+      fgAsyncWriter->Push(fProducerId, eventId, edep, secE, secEnergy, secType, secWeight);
+      return;
+    }
+    fSecondaries->AddEvent(eventId, edep, secE, secEnergy, secType, secWeight);
+}
+
+void RunAction::SetSharedMemory(const G4String& name)
+{
+  // POSIX shared-memory names start with a slash
+  if (name.empty() || name == "none") fSharedMemoryName = "";
+  else if (name[0] == '/') fSharedMemoryName = name;
+  else fSharedMemoryName = "/" + name;
+}
+
+void RunAction::SetCascadeBuildFile(const G4String& fileName)
+{
+  fCascadeBuildFile = (fileName == "none") ? "" : fileName;
+}
+
+void RunAction::SetCascadeReplayFile(const G4String& fileName)
+{
+  fReplayFile = (fileName == "none") ? "" : fileName;
+}
+
+void RunAction::SetBlockSize(G4int blockSize)
+{
+    fSecondaries->SetBlockCapacity(blockSize);
+}
+
+G4bool RunAction::SetHistoBinning(const G4String& name, G4int nbins, G4double xmin,
+                                  G4double xmax, H1Accumulable::Binning binning)
+{
+  for (auto histo : fHistos) {
+    if (histo->GetName() == name) {
+      histo->SetBinning(nbins, xmin, xmax, binning);
+      return true;
+    }
+  }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::unique_ptr<VRecordWriter> RunAction::CreateRecordWriter() const
+{
+  std::unique_ptr<VRecordWriter> writer;
+  switch (fOutputFormat) {
+    case OutputFormat::Text:
+      writer = std::make_unique<TextRecordWriter>();
+      break;
+    case OutputFormat::Binary:
+      writer = std::make_unique<BinaryRecordWriter>(fCompressionLevel);
+      break;
+    default:
+      writer = std::make_unique<IndexedRecordWriter>();
+  }
+  writer->SetPrimary(fRunConditions->GetParticleName(), fRunConditions->GetEnergy() / MeV);
+  const auto detConstruction = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  writer->SetWeighted(detConstruction->IsBiased());
+  return writer;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::CloseShard()
+{
+  fSecondaries->Flush();
+  fShardWriter->Close();
+
+  ShardManifest::Shard shard;
+  shard.fThreadId = std::max(G4Threading::G4GetThreadId(), 0);
+  shard.fFiles = fShardWriter->GetFileNames(
+    GetOutputSuffix() + "_t" + std::to_string(shard.fThreadId));
+  shard.fNofEvents = fShardWriter->GetNumberOfEvents();
+  shard.fNofSecondaries = fShardWriter->GetNumberOfSecondaries();
+  fShardManifest->AddShard(shard);
+
+  fSecondaries->SetBlockSink(nullptr);
+  fShardWriter.reset();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
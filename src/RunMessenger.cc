@@ -0,0 +1,319 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/RunMessenger.cc
+/// \brief Implementation of the GdNCap::RunMessenger class
+
+#include "RunMessenger.hh"
+#include "RunAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+
+#include <sstream>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunMessenger::RunMessenger(RunAction* runAction)
+: fRunAction(runAction)
+{
+  fDirectory = new G4UIdirectory("/GdNCap/");
+  fDirectory->SetGuidance("UI commands of the GdNeutronCapture application");
+
+  fOutputDirectory = new G4UIdirectory("/GdNCap/output/");
+  fOutputDirectory->SetGuidance("Capture record output control");
+
+  fOutputModeCmd = new G4UIcmdWithAString("/GdNCap/output/mode", this);
+  fOutputModeCmd->SetGuidance("Select how capture records are stored.");
+  fOutputModeCmd->SetGuidance("  memory : keep all records until the end of run,");
+  fOutputModeCmd->SetGuidance("           the master writes the record files");
+  fOutputModeCmd->SetGuidance("  stream : each thread flushes full blocks of records");
+  fOutputModeCmd->SetGuidance("           to its own shard files during the run,");
+  fOutputModeCmd->SetGuidance("           the master only writes SecondaryManifest.txt");
+  fOutputModeCmd->SetGuidance("  async  : worker threads queue each event's records to an");
+  fOutputModeCmd->SetGuidance("           I/O thread of the master writing them during the run");
+  fOutputModeCmd->SetGuidance("  analysis : fill the Events and Secondaries ntuples of");
+  fOutputModeCmd->SetGuidance("           G4AnalysisManager, see ntupleFileType");
+  fOutputModeCmd->SetGuidance("  none   : do not store records, only the histograms");
+  fOutputModeCmd->SetParameterName("mode", false);
+  fOutputModeCmd->SetCandidates("memory stream async analysis none");
+  fOutputModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fOutputFormatCmd = new G4UIcmdWithAString("/GdNCap/output/format", this);
+  fOutputFormatCmd->SetGuidance("Select the layout of the capture record files.");
+  fOutputFormatCmd->SetGuidance("  record : CaptureRecords.txt, one line per event in event ID");
+  fOutputFormatCmd->SetGuidance("           order, with the offset index CaptureRecords.idx");
+  fOutputFormatCmd->SetGuidance("  text   : legacy SecondaryTotalEnergy/Energy/Name.txt files");
+  fOutputFormatCmd->SetGuidance("  binary : CaptureRecords.gdnc columnar blocks, read with the");
+  fOutputFormatCmd->SetGuidance("           GdNCapReader library or gdncap-convert");
+  fOutputFormatCmd->SetParameterName("format", false);
+  fOutputFormatCmd->SetCandidates("record text binary");
+  fOutputFormatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fOutputTagCmd = new G4UIcmdWithAString("/GdNCap/output/tag", this);
+  fOutputTagCmd->SetGuidance("Append \"_<tag>\" to the names of the record, manifest,");
+  fOutputTagCmd->SetGuidance("histogram and ntuple files, e.g. for one point of a sweep.");
+  fOutputTagCmd->SetGuidance("\"none\" clears the tag.");
+  fOutputTagCmd->SetParameterName("tag", false);
+  fOutputTagCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fCompressionCmd = new G4UIcmdWithAnInteger("/GdNCap/output/compression", this);
+  fCompressionCmd->SetGuidance("zlib level of the binary record blocks, 0 = uncompressed.");
+  fCompressionCmd->SetParameterName("level", false);
+  fCompressionCmd->SetRange("level>=0 && level<=9");
+  fCompressionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBlockSizeCmd = new G4UIcmdWithAnInteger("/GdNCap/output/blockSize", this);
+  fBlockSizeCmd->SetGuidance("Number of events per record block.");
+  fBlockSizeCmd->SetGuidance("In stream mode this bounds the records held per thread.");
+  fBlockSizeCmd->SetParameterName("events", false);
+  fBlockSizeCmd->SetRange("events>0");
+  fBlockSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fWriterThreadsCmd = new G4UIcmdWithAnInteger("/GdNCap/output/writerThreads", this);
+  fWriterThreadsCmd->SetGuidance("Number of threads formatting the text record files");
+  fWriterThreadsCmd->SetGuidance("written by the master at the end of run, 0 = all cores.");
+  fWriterThreadsCmd->SetParameterName("threads", false);
+  fWriterThreadsCmd->SetRange("threads>=0");
+  fWriterThreadsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fQueueSizeCmd = new G4UIcmdWithAnInteger("/GdNCap/output/queueSize", this);
+  fQueueSizeCmd->SetGuidance("Capacity in events of the queue feeding the I/O thread in");
+  fQueueSizeCmd->SetGuidance("async mode, rounded up to a power of two. Worker threads");
+  fQueueSizeCmd->SetGuidance("wait while it is full. The records held by the I/O thread to");
+  fQueueSizeCmd->SetGuidance("restore the event order count against the same capacity.");
+  fQueueSizeCmd->SetParameterName("events", false);
+  fQueueSizeCmd->SetRange("events>0");
+  fQueueSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSharedMemoryCmd = new G4UIcmdWithAString("/GdNCap/output/sharedMemory", this);
+  fSharedMemoryCmd->SetGuidance("Also publish every event live to the POSIX shared-memory");
+  fSharedMemoryCmd->SetGuidance("ring of this name, e.g. for reader/gdncap-monitor.");
+  fSharedMemoryCmd->SetGuidance("\"none\" stops publishing.");
+  fSharedMemoryCmd->SetParameterName("name", false);
+  fSharedMemoryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSharedMemorySlotsCmd = new G4UIcmdWithAnInteger("/GdNCap/output/sharedMemorySlots", this);
+  fSharedMemorySlotsCmd->SetGuidance("Number of events held by the shared-memory ring,");
+  fSharedMemorySlotsCmd->SetGuidance("rounded up to a power of two.");
+  fSharedMemorySlotsCmd->SetParameterName("events", false);
+  fSharedMemorySlotsCmd->SetRange("events>0");
+  fSharedMemorySlotsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fNtupleFileTypeCmd = new G4UIcmdWithAString("/GdNCap/output/ntupleFileType", this);
+  fNtupleFileTypeCmd->SetGuidance("File type of CaptureNtuples in analysis mode.");
+  fNtupleFileTypeCmd->SetGuidance("csv and hdf5 are written per thread; root ntuples are");
+  fNtupleFileTypeCmd->SetGuidance("merged into one file unless ntupleMerging is false.");
+  fNtupleFileTypeCmd->SetParameterName("type", false);
+  fNtupleFileTypeCmd->SetCandidates("csv hdf5 root");
+  fNtupleFileTypeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fNtupleMergingCmd = new G4UIcmdWithABool("/GdNCap/output/ntupleMerging", this);
+  fNtupleMergingCmd->SetGuidance("Merge the worker ntuples into the master ROOT file.");
+  fNtupleMergingCmd->SetParameterName("merging", true);
+  fNtupleMergingCmd->SetDefaultValue(true);
+  fNtupleMergingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fHistoDirectory = new G4UIdirectory("/GdNCap/histo/");
+  fHistoDirectory->SetGuidance("Capture spectra histograms");
+
+  fHistoBinningCmd = new G4UIcommand("/GdNCap/histo/setBinning", this);
+  fHistoBinningCmd->SetGuidance("Set the binning of a histogram and reset it.");
+  fHistoBinningCmd->SetGuidance("Energies (gammaEnergy, captureEnergy, edep) are in MeV,");
+  fHistoBinningCmd->SetGuidance("depths (captureDepth) in mm, times (eventTime, eventCpuTime) in us.");
+  auto nameParam = new G4UIparameter("name", 's', false);
+  nameParam->SetParameterCandidates(
+    "gammaEnergy captureEnergy multiplicity edep captureDepth eventTime eventCpuTime");
+  fHistoBinningCmd->SetParameter(nameParam);
+  auto nbinsParam = new G4UIparameter("nbins", 'i', false);
+  nbinsParam->SetParameterRange("nbins>0");
+  fHistoBinningCmd->SetParameter(nbinsParam);
+  fHistoBinningCmd->SetParameter(new G4UIparameter("xmin", 'd', false));
+  fHistoBinningCmd->SetParameter(new G4UIparameter("xmax", 'd', false));
+  auto binningParam = new G4UIparameter("binning", 's', true);
+  binningParam->SetParameterCandidates("linear log");
+  binningParam->SetDefaultValue("linear");
+  fHistoBinningCmd->SetParameter(binningParam);
+  fHistoBinningCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fCascadeDirectory = new G4UIdirectory("/GdNCap/cascade/");
+  fCascadeDirectory->SetGuidance("Library of capture-gamma cascades by target isotope");
+
+  fCascadeBuildCmd = new G4UIcmdWithAString("/GdNCap/cascade/build", this);
+  fCascadeBuildCmd->SetGuidance("Store the gammas of every capture of the next runs by");
+  fCascadeBuildCmd->SetGuidance("target isotope, and write them to this library file at");
+  fCascadeBuildCmd->SetGuidance("the end of each run. \"none\" stops building.");
+  fCascadeBuildCmd->SetParameterName("file", false);
+  fCascadeBuildCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fCascadeMaxPerIsotopeCmd = new G4UIcmdWithAnInteger("/GdNCap/cascade/maxPerIsotope", this);
+  fCascadeMaxPerIsotopeCmd->SetGuidance("Maximum number of cascades stored per isotope while");
+  fCascadeMaxPerIsotopeCmd->SetGuidance("building, 0 = no limit. Further captures are only counted.");
+  fCascadeMaxPerIsotopeCmd->SetParameterName("cascades", false);
+  fCascadeMaxPerIsotopeCmd->SetRange("cascades>=0");
+  fCascadeMaxPerIsotopeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fCascadeReplayCmd = new G4UIcmdWithAString("/GdNCap/cascade/replay", this);
+  fCascadeReplayCmd->SetGuidance("Replace the particle gun by cascades drawn from this");
+  fCascadeReplayCmd->SetGuidance("library file, emitted as isotropic gammas from a point");
+  fCascadeReplayCmd->SetGuidance("uniform in the envelope. \"none\" restores the gun.");
+  fCascadeReplayCmd->SetParameterName("file", false);
+  fCascadeReplayCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fCascadeReplayIsotopeCmd = new G4UIcommand("/GdNCap/cascade/replayIsotope", this);
+  fCascadeReplayIsotopeCmd->SetGuidance("Replay the cascades of the isotope (Z, A) only; with");
+  fCascadeReplayIsotopeCmd->SetGuidance("Z = 0, of all isotopes in their capture proportions.");
+  auto zParam = new G4UIparameter("Z", 'i', false);
+  zParam->SetParameterRange("Z>=0");
+  fCascadeReplayIsotopeCmd->SetParameter(zParam);
+  auto aParam = new G4UIparameter("A", 'i', true);
+  aParam->SetDefaultValue(0);
+  fCascadeReplayIsotopeCmd->SetParameter(aParam);
+  fCascadeReplayIsotopeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunMessenger::~RunMessenger()
+{
+  delete fCascadeReplayIsotopeCmd;
+  delete fCascadeReplayCmd;
+  delete fCascadeMaxPerIsotopeCmd;
+  delete fCascadeBuildCmd;
+  delete fCascadeDirectory;
+  delete fHistoBinningCmd;
+  delete fHistoDirectory;
+  delete fNtupleMergingCmd;
+  delete fNtupleFileTypeCmd;
+  delete fSharedMemorySlotsCmd;
+  delete fSharedMemoryCmd;
+  delete fQueueSizeCmd;
+  delete fWriterThreadsCmd;
+  delete fBlockSizeCmd;
+  delete fCompressionCmd;
+  delete fOutputTagCmd;
+  delete fOutputFormatCmd;
+  delete fOutputModeCmd;
+  delete fOutputDirectory;
+  delete fDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fOutputModeCmd) {
+    if (newValue == "stream") fRunAction->SetOutputMode(RunAction::OutputMode::Stream);
+    else if (newValue == "async") fRunAction->SetOutputMode(RunAction::OutputMode::Async);
+    else if (newValue == "analysis") fRunAction->SetOutputMode(RunAction::OutputMode::Analysis);
+    else if (newValue == "none") fRunAction->SetOutputMode(RunAction::OutputMode::None);
+    else fRunAction->SetOutputMode(RunAction::OutputMode::Memory);
+  }
+  else if (command == fOutputFormatCmd) {
+    if (newValue == "text") fRunAction->SetOutputFormat(RunAction::OutputFormat::Text);
+    else if (newValue == "binary") fRunAction->SetOutputFormat(RunAction::OutputFormat::Binary);
+    else fRunAction->SetOutputFormat(RunAction::OutputFormat::Record);
+  }
+  else if (command == fCompressionCmd) {
+    fRunAction->SetCompressionLevel(fCompressionCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fBlockSizeCmd) {
+    fRunAction->SetBlockSize(fBlockSizeCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fWriterThreadsCmd) {
+    fRunAction->SetWriterThreads(fWriterThreadsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fQueueSizeCmd) {
+    fRunAction->SetQueueCapacity(fQueueSizeCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fOutputTagCmd) {
+    fRunAction->SetOutputTag(newValue);
+  }
+  else if (command == fSharedMemoryCmd) {
+    fRunAction->SetSharedMemory(newValue);
+  }
+  else if (command == fSharedMemorySlotsCmd) {
+    fRunAction->SetSharedMemorySlots(fSharedMemorySlotsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fNtupleFileTypeCmd) {
+    fRunAction->SetNtupleFileType(newValue);
+  }
+  else if (command == fNtupleMergingCmd) {
+    fRunAction->SetNtupleMerging(fNtupleMergingCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fHistoBinningCmd) {
+    std::istringstream is(newValue);
+    G4String name, binning;
+    G4int nbins;
+    G4double xmin, xmax;
+    is >> name >> nbins >> xmin >> xmax >> binning;
+    fRunAction->SetHistoBinning(name, nbins, xmin, xmax,
+      binning == "log" ? H1Accumulable::Binning::Log : H1Accumulable::Binning::Linear);
+  }
+  else if (command == fCascadeBuildCmd) {
+    fRunAction->SetCascadeBuildFile(newValue);
+  }
+  else if (command == fCascadeMaxPerIsotopeCmd) {
+    fRunAction->SetCascadeMaxPerIsotope(fCascadeMaxPerIsotopeCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fCascadeReplayCmd) {
+    fRunAction->SetCascadeReplayFile(newValue);
+  }
+  else if (command == fCascadeReplayIsotopeCmd) {
+    std::istringstream is(newValue);
+    G4int Z = 0, A = 0;
+    is >> Z >> A;
+    fRunAction->SetCascadeReplayIsotope(Z, A);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String RunMessenger::GetCurrentValue(G4UIcommand* command)
+{
+  if (command == fOutputModeCmd) {
+    switch (fRunAction->GetOutputMode()) {
+      case RunAction::OutputMode::Stream: return "stream";
+      case RunAction::OutputMode::Async: return "async";
+      case RunAction::OutputMode::Analysis: return "analysis";
+      case RunAction::OutputMode::None: return "none";
+      case RunAction::OutputMode::Memory: return "memory";
+    }
+  }
+  if (command == fOutputTagCmd) {
+    return fRunAction->GetOutputTag().empty() ? G4String("none") : fRunAction->GetOutputTag();
+  }
+  return "";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
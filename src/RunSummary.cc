@@ -0,0 +1,132 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/RunSummary.cc
+/// \brief Implementation of the GdNCap::RunSummary class
+
+#include "RunSummary.hh"
+
+#include <sstream>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunSummary* RunSummary::Instance()
+{
+  static RunSummary instance;
+  return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunSummary::Open(const G4String& fileName)
+{
+  fFile.open(fileName, std::ios_base::out);
+  if (!fFile) {
+    G4ExceptionDescription msg;
+    msg << "Cannot create " << fileName << ", no job summary is written.";
+    G4Exception("RunSummary::Open()", "MyCode0011", JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunSummary::AddEntry(const G4String& key, const G4String& value)
+{
+  if (!IsOpen()) return;
+  fFile << key << " " << value << std::endl;
+}
+
+void RunSummary::AddInitialization(G4double seconds)
+{
+  if (!IsOpen()) return;
+  fFile << "initialization " << seconds << std::endl;
+}
+
+void RunSummary::AddRunInitialization(G4int runId, G4double seconds)
+{
+  if (!IsOpen()) return;
+  fFile << "runInitialization " << runId << " " << seconds << std::endl;
+}
+
+void RunSummary::AddRun(G4int runId, G4int nofEvents, G4double seconds)
+{
+  if (!IsOpen()) return;
+  fFile << "run " << runId << " " << nofEvents << " " << seconds << std::endl;
+}
+
+void RunSummary::AddPhase(const G4String& name, G4double seconds)
+{
+  if (!IsOpen()) return;
+  fFile << "phase " << name << " " << seconds << std::endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunSummary::Entries RunSummary::Read(const G4String& fileName)
+{
+  Entries entries;
+  std::ifstream file(fileName);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream is(line);
+    G4String key;
+    if (!(is >> key)) continue;
+    std::vector<G4String> values;
+    G4String value;
+    while (is >> value) values.push_back(value);
+    entries.emplace(key, values);
+  }
+  return entries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunSummary::Totals RunSummary::GetTotals(const Entries& entries)
+{
+  Totals totals;
+  for (const auto& [key, values] : entries) {
+    if (key == "initialization" && !values.empty()) {
+      totals.fInitTime += std::stod(values[0]);
+    }
+    else if (key == "runInitialization" && values.size() >= 2 && values[0] == "0") {
+      totals.fInitTime += std::stod(values[1]);
+    }
+    else if (key == "run" && values.size() >= 3) {
+      totals.fLastRunEvents = std::stoi(values[1]);
+      totals.fLastRunTime = std::stod(values[2]);
+      totals.fNofEvents += totals.fLastRunEvents;
+      totals.fEventTime += totals.fLastRunTime;
+    }
+  }
+  return totals;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
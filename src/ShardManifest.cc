@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/ShardManifest.cc
+/// \brief Implementation of the GdNCap::ShardManifest class
+
+#include "ShardManifest.hh"
+
+#include <algorithm>
+#include <fstream>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardManifest::Merge(const G4VAccumulable& other)
+{
+  const auto& otherManifest = static_cast<const ShardManifest&>(other);
+  fShards.insert(fShards.end(),
+    otherManifest.fShards.begin(), otherManifest.fShards.end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardManifest::Reset()
+{
+  fShards.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardManifest::Write(const G4String& fileName) const
+{
+  // Threads finish in arbitrary order, list the shards by thread
+  auto shards = fShards;
+  std::sort(shards.begin(), shards.end(),
+    [](const Shard& a, const Shard& b) { return a.fThreadId < b.fThreadId; });
+
+  std::ofstream manifestFile(fileName, std::ios_base::out);
+  manifestFile << "# thread events secondaries files...\n";
+  for (const auto& shard : shards) {
+    manifestFile << shard.fThreadId << " "
+                 << shard.fNofEvents << " "
+                 << shard.fNofSecondaries;
+    for (const auto& file : shard.fFiles) manifestFile << " " << file;
+    manifestFile << "\n";
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,212 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/SharedMemorySink.cc
+/// \brief Implementation of the GdNCap::SharedMemorySink class
+
+#include "SharedMemorySink.hh"
+
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define GDNCAP_HAVE_SHM 1
+#endif
+
+namespace
+{
+  G4Mutex typesMutex = G4MUTEX_INITIALIZER;
+}
+
+namespace GdNCap
+{
+
+using namespace SharedMemoryFormat;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SharedMemorySink::SharedMemorySink(const G4String& name, std::size_t nofSlots,
+                                   std::size_t maxSecondaries)
+: fName(name), fMaxSecondaries(maxSecondaries)
+{
+  // POSIX shared-memory names start with a slash
+  if (fName.empty() || fName[0] != '/') fName.insert(0, "/");
+  fNofSlots = 2;
+  while (fNofSlots < nofSlots) fNofSlots <<= 1;
+  const std::size_t headerSize = Align(sizeof(RingHeader));
+  const std::size_t slotSize = GetSlotSize(fMaxSecondaries);
+  fSize = headerSize + fNofSlots * slotSize;
+
+#ifdef GDNCAP_HAVE_SHM
+  // A stale object of a crashed run is replaced
+  shm_unlink(fName.c_str());
+  int fd = shm_open(fName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  void* address = MAP_FAILED;
+  if (fd >= 0) {
+    if (ftruncate(fd, fSize) == 0) {
+      address = mmap(nullptr, fSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+  }
+  if (address == MAP_FAILED) {
+    if (fd >= 0) shm_unlink(fName.c_str());
+    G4ExceptionDescription msg;
+    msg << "Cannot create the shared-memory object " << fName
+        << " of " << fSize << " bytes, events are not published.";
+    G4Exception("SharedMemorySink::SharedMemorySink()", "MyCode0008",
+      JustWarning, msg);
+    return;
+  }
+
+  // The object is zero-filled: every slot sequence starts at 0
+  fHeader = new (address) RingHeader;
+  fSlots = static_cast<char*>(address) + headerSize;
+  fHeader->fVersion = kVersion;
+  fHeader->fHeaderSize = headerSize;
+  fHeader->fNofSlots = fNofSlots;
+  fHeader->fSlotSize = slotSize;
+  fHeader->fMaxSecondaries = fMaxSecondaries;
+  fHeader->fProducerPid = getpid();
+  fHeader->fWritePos.store(0);
+  fHeader->fRunId.store(0);
+  fHeader->fNofTypes.store(0);
+  fHeader->fState.store(0);
+  // The magic comes last: consumers check it before anything else
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(fHeader->fMagic, kMagic, sizeof(fHeader->fMagic));
+#else
+  G4Exception("SharedMemorySink::SharedMemorySink()", "MyCode0008",
+    JustWarning, "POSIX shared memory is not available, events are not published.");
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SharedMemorySink::~SharedMemorySink()
+{
+  if (!fHeader) return;
+  fHeader->fState.store(kFinished, std::memory_order_release);
+#ifdef GDNCAP_HAVE_SHM
+  munmap(fHeader, fSize);
+  shm_unlink(fName.c_str());
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SharedMemorySink::BeginRun()
+{
+  if (!fHeader) return;
+  fHeader->fRunId.fetch_add(1, std::memory_order_relaxed);
+  fHeader->fState.store(kRunning, std::memory_order_release);
+}
+
+void SharedMemorySink::EndRun()
+{
+  if (!fHeader) return;
+  fHeader->fState.store(0, std::memory_order_release);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+Slot* SharedMemorySink::GetSlot(std::uint64_t pos) const
+{
+  return reinterpret_cast<Slot*>(fSlots + (pos & (fNofSlots - 1)) * fHeader->fSlotSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SharedMemorySink::Publish(G4int eventId, G4double edep, G4double totalEnergy,
+                               const std::vector<G4double>& energies,
+                               const std::vector<ParticleTypeTable::TypeId>& types,
+                               const std::vector<G4double>& weights)
+{
+  if (!fHeader) return;
+
+  // Type names are published before a slot refers to them
+  std::uint32_t nofTypes = fHeader->fNofTypes.load(std::memory_order_acquire);
+  for (auto type : types) {
+    if (type >= nofTypes) {
+      PublishTypes();
+      break;
+    }
+  }
+
+  std::uint64_t pos = fHeader->fWritePos.fetch_add(1, std::memory_order_relaxed);
+  Slot* slot = GetSlot(pos);
+
+  // A writer of the previous lap may still be filling the slot
+  const std::uint64_t previous = pos >= fNofSlots ? 2 * (pos - fNofSlots) + 2 : 0;
+  while (slot->fSequence.load(std::memory_order_acquire) < previous) {
+    std::this_thread::yield();
+  }
+
+  slot->fSequence.store(2 * pos + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const std::size_t nofStored = std::min(energies.size(), fMaxSecondaries);
+  slot->fEventId = eventId;
+  slot->fRunId = fHeader->fRunId.load(std::memory_order_relaxed);
+  slot->fNofSecondaries = nofStored;
+  slot->fMultiplicity = energies.size();
+  slot->fEdep = edep;
+  slot->fTotalEnergy = totalEnergy;
+  auto slotEnergies = const_cast<double*>(GetEnergies(slot));
+  auto slotWeights = const_cast<double*>(GetWeights(slot, fMaxSecondaries));
+  auto slotTypes = const_cast<std::uint8_t*>(GetTypes(slot, fMaxSecondaries));
+  std::copy_n(energies.begin(), nofStored, slotEnergies);
+  std::copy_n(weights.begin(), nofStored, slotWeights);
+  std::copy_n(types.begin(), nofStored, slotTypes);
+
+  slot->fSequence.store(2 * pos + 2, std::memory_order_release);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SharedMemorySink::PublishTypes()
+{
+  G4AutoLock lock(&typesMutex);
+  auto table = ParticleTypeTable::Instance();
+  std::uint32_t first = fHeader->fNofTypes.load(std::memory_order_relaxed);
+  std::uint32_t last = table->GetNumberOfTypes();
+  for (std::uint32_t id = first; id < last; ++id) {
+    char* name = fHeader->fTypeNames[id];
+    std::strncpy(name, table->GetName(id).c_str(), kTypeNameLength - 1);
+    name[kTypeNameLength - 1] = '\0';
+  }
+  fHeader->fNofTypes.store(last, std::memory_order_release);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
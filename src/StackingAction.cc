@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/StackingAction.cc
+/// \brief Implementation of the GdNCap::StackingAction class
+
+#include "StackingAction.hh"
+#include "CaptureFilter.hh"
+
+#include "G4Gamma.hh"
+#include "G4Neutron.hh"
+#include "G4Track.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingAction::StackingAction(const CaptureFilter* captureFilter)
+: fCaptureFilter(captureFilter), fGamma(G4Gamma::Definition()),
+  fNeutron(G4Neutron::Definition())
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  using Transport = CaptureFilter::Transport;
+  const Transport transport = fCaptureFilter->GetTransport();
+  if (transport == Transport::Full || track->GetParentID() == 0) return fUrgent;
+
+  // The neutron clones of the splitting and forced-collision biasing
+  // carry part of the primary weight: killing them would bias the tallies
+  if (track->GetParticleDefinition() == fNeutron) return fUrgent;
+
+  if (transport == Transport::CaptureGammas
+      && track->GetParticleDefinition() == fGamma
+      && fCaptureFilter->IsCaptureProcess(track->GetCreatorProcess())) {
+    return fUrgent;
+  }
+  return fKill;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,181 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/StartupMonitor.cc
+/// \brief Implementation of the GdNCap::StartupMonitor class
+
+#include "StartupMonitor.hh"
+#include "RunSummary.hh"
+
+#include "G4StateManager.hh"
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace
+{
+  G4Mutex firstEventMutex = G4MUTEX_INITIALIZER;
+}
+
+namespace GdNCap
+{
+
+StartupMonitor* StartupMonitor::fgInstance = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StartupMonitor::StartupMonitor()
+{
+  fgInstance = this;
+  fTotalTimer.Start();
+}
+
+StartupMonitor::~StartupMonitor()
+{
+  fgInstance = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool StartupMonitor::Notify(G4ApplicationState requestedState)
+{
+  // Called before the change, the current state is still the old one
+  const G4ApplicationState state = G4StateManager::GetStateManager()->GetCurrentState();
+  if (requestedState == state) return true;
+
+  if (state == G4State_Init) {
+    fTimer.Stop();
+    fPending = true;
+    fPendingTime = fTimer.GetRealElapsed();
+  }
+  else if (state == G4State_Idle && requestedState == G4State_GeomClosed && fPending) {
+    fPending = false;
+    G4cout << " Run initialization: " << fPendingTime << " s" << G4endl;
+    RunSummary::Instance()->AddRunInitialization(fNofRunInitializations, fPendingTime);
+    if (fNofRunInitializations++ == 0) {
+      AddPhase("physicsTables", fPendingTime);
+      fFirstEventTimer.Start();
+    }
+  }
+  else {
+    ReportInitialization();
+  }
+  if (requestedState == G4State_Init) fTimer.Start();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StartupMonitor::ReportInitialization()
+{
+  if (!fPending) return;
+  fPending = false;
+  G4cout << " Initialization: " << fPendingTime << " s" << G4endl;
+  RunSummary::Instance()->AddInitialization(fPendingTime);
+  // The first /run/initialize builds the geometry, then the physics
+  if (fNofRunInitializations == 0) {
+    AddPhase("physics", std::max(fPendingTime - fGeometryTime, 0.));
+    fGeometryTime = 0.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StartupMonitor::BeginPhase(const G4String& name)
+{
+  EndPhase();
+  fPhase = name;
+  fPhaseTimer.Start();
+}
+
+void StartupMonitor::EndPhase()
+{
+  if (fPhase.empty()) return;
+  fPhaseTimer.Stop();
+  AddPhase(fPhase, fPhaseTimer.GetRealElapsed());
+  fPhase.clear();
+}
+
+void StartupMonitor::AddPhase(const G4String& name, G4double seconds)
+{
+  // Only the startup counts, e.g. not a geometry rebuilt between runs
+  if (fFirstEventDone) return;
+  if (name == "geometry") fGeometryTime += seconds;
+  fPhases.emplace_back(name, seconds);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StartupMonitor::EndEvent()
+{
+  if (fFirstEventDone.load(std::memory_order_relaxed)) return;
+  G4AutoLock lock(&firstEventMutex);
+  if (fFirstEventDone) return;
+  fFirstEventTimer.Stop();
+  fTotalTimer.Stop();
+  fFirstEventDone = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StartupMonitor::Report()
+{
+  if (fReported || !fFirstEventDone) return;
+  fReported = true;
+
+  auto phases = fPhases;
+  phases.emplace_back("firstEvent", fFirstEventTimer.GetRealElapsed());
+  const G4double total = fTotalTimer.GetRealElapsed();
+  G4double other = total;
+  for (const auto& phase : phases) other -= phase.second;
+  phases.emplace_back("other", std::max(other, 0.));
+
+  const auto precision = G4cout.precision(3);
+  G4cout
+    << G4endl
+    << "--------------------Startup profile-------------------------"
+    << G4endl;
+  for (const auto& [name, seconds] : phases) {
+    G4cout
+      << " " << std::left << std::setw(16) << name << std::right
+      << std::setw(10) << seconds << " s"
+      << std::setw(8)
+      << (total > 0. ? 100. * seconds / total : 0.) << " %" << G4endl;
+    RunSummary::Instance()->AddPhase(name, seconds);
+  }
+  G4cout
+    << " " << std::left << std::setw(16) << "total" << std::right
+    << std::setw(10) << total << " s" << G4endl
+    << "------------------------------------------------------------"
+    << G4endl;
+  G4cout.precision(precision);
+  RunSummary::Instance()->AddPhase("total", total);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
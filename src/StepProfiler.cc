@@ -0,0 +1,244 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/StepProfiler.cc
+/// \brief Implementation of the GdNCap::StepProfiler class
+
+#include "StepProfiler.hh"
+#include "StepProfilerMessenger.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepProfiler::StepProfiler()
+: G4VAccumulable("stepProfile")
+{
+  fMessenger = new StepProfilerMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepProfiler::~StepProfiler()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int StepProfiler::PointerIds::Get(const void* pointer)
+{
+  // Consecutive steps mostly share the volume and particle
+  if (pointer == fLast) return fLastId;
+  auto [it, inserted] = fIds.try_emplace(pointer, G4int(fPointers.size()));
+  if (inserted) fPointers.push_back(pointer);
+  fLast = pointer;
+  fLastId = it->second;
+  return fLastId;
+}
+
+void StepProfiler::PointerIds::Clear()
+{
+  fIds.clear();
+  fPointers.clear();
+  fLast = nullptr;
+  fLastId = -1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::AddStep(const G4LogicalVolume* volume,
+                           const G4ParticleDefinition* particle,
+                           const G4VProcess* process, G4double stepLength,
+                           Clock::duration time)
+{
+  const std::size_t volumeId = fVolumeIds.Get(volume);
+  const std::size_t particleId = fParticleIds.Get(particle);
+  const std::size_t processId = fProcessIds.Get(process);
+
+  // The table only grows when a new pointer is met
+  if (volumeId >= fCells.size()) fCells.resize(volumeId + 1);
+  auto& particleCells = fCells[volumeId];
+  if (particleId >= particleCells.size()) particleCells.resize(particleId + 1);
+  auto& processCells = particleCells[particleId];
+  if (processId >= processCells.size()) processCells.resize(processId + 1);
+
+  Cell& cell = processCells[processId];
+  ++cell.fNofSteps;
+  cell.fTrackLength += stepLength;
+  cell.fTime += time.count();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Flush()
+{
+  const auto& volumes = fVolumeIds.GetPointers();
+  const auto& particles = fParticleIds.GetPointers();
+  const auto& processes = fProcessIds.GetPointers();
+  for (std::size_t volumeId = 0; volumeId < fCells.size(); ++volumeId) {
+    const auto volume = static_cast<const G4LogicalVolume*>(volumes[volumeId]);
+    for (std::size_t particleId = 0; particleId < fCells[volumeId].size(); ++particleId) {
+      const auto particle = static_cast<const G4ParticleDefinition*>(particles[particleId]);
+      const auto& processCells = fCells[volumeId][particleId];
+      for (std::size_t processId = 0; processId < processCells.size(); ++processId) {
+        const Cell& cell = processCells[processId];
+        if (cell.fNofSteps == 0) continue;
+        const auto process = static_cast<const G4VProcess*>(processes[processId]);
+        Key key(volume ? volume->GetName() : G4String("none"),
+                particle->GetParticleName(),
+                process ? process->GetProcessName() : G4String("none"));
+        Entry& entry = fEntries[key];
+        entry.fNofSteps += cell.fNofSteps;
+        entry.fTrackLength += cell.fTrackLength;
+        entry.fTime += std::chrono::duration<G4double>(Clock::duration(cell.fTime)).count();
+      }
+    }
+  }
+  fCells.clear();
+  fVolumeIds.Clear();
+  fParticleIds.Clear();
+  fProcessIds.Clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Merge(const G4VAccumulable& other)
+{
+  const auto& otherProfiler = static_cast<const StepProfiler&>(other);
+  for (const auto& [key, otherEntry] : otherProfiler.fEntries) {
+    Entry& entry = fEntries[key];
+    entry.fNofSteps += otherEntry.fNofSteps;
+    entry.fTrackLength += otherEntry.fTrackLength;
+    entry.fTime += otherEntry.fTime;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Reset()
+{
+  // The pointers may be reused by a new geometry or physics
+  fCells.clear();
+  fVolumeIds.Clear();
+  fParticleIds.Clear();
+  fProcessIds.Clear();
+  fEntries.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<StepProfiler::Entry> StepProfiler::GetEntries() const
+{
+  std::vector<Entry> entries;
+  entries.reserve(fEntries.size());
+  for (const auto& [key, entry] : fEntries) {
+    entries.push_back(entry);
+    std::tie(entries.back().fVolume, entries.back().fParticle, entries.back().fProcess) = key;
+  }
+  std::sort(entries.begin(), entries.end(),
+    [](const Entry& a, const Entry& b) { return a.fTime > b.fTime; });
+  return entries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t StepProfiler::GetMemoryUsage() const
+{
+  std::size_t bytes = sizeof(StepProfiler);
+  for (const auto& particleCells : fCells) {
+    for (const auto& processCells : particleCells) bytes += processCells.capacity() * sizeof(Cell);
+  }
+  // A map node holds the key and entry besides three pointers and a color
+  for (const auto& [key, entry] : fEntries) {
+    bytes += sizeof(Key) + sizeof(Entry) + 4 * sizeof(void*)
+      + std::get<0>(key).capacity() + std::get<1>(key).capacity() + std::get<2>(key).capacity();
+  }
+  const std::size_t nofPointers = fVolumeIds.GetPointers().size()
+    + fParticleIds.GetPointers().size() + fProcessIds.GetPointers().size();
+  return bytes + nofPointers * 4 * sizeof(void*);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfiler::Report() const
+{
+  if (!fEnabled || fEntries.empty()) return;
+  const auto entries = GetEntries();
+  G4long nofSteps = 0;
+  G4double time = 0.;
+  for (const auto& entry : entries) {
+    nofSteps += entry.fNofSteps;
+    time += entry.fTime;
+  }
+
+  std::ofstream file(fFileName, std::ios_base::out);
+  file << "# volume particle process steps trackLength[mm] time[s]\n";
+  for (const auto& entry : entries) {
+    file << entry.fVolume << " " << entry.fParticle << " " << entry.fProcess << " "
+         << entry.fNofSteps << " " << entry.fTrackLength / mm << " " << entry.fTime << "\n";
+  }
+
+  const auto precision = G4cout.precision(3);
+  G4cout
+    << G4endl
+    << " Step profile: " << nofSteps << " steps, " << time
+    << " s in the stepping action, " << entries.size() << " (volume, particle, process)"
+    << " in " << fFileName << ", by time:"
+    << G4endl
+    << std::setw(16) << "volume" << std::setw(16) << "particle" << std::setw(20) << "process"
+    << std::setw(12) << "steps" << std::setw(8) << "%" << std::setw(14) << "length [m]"
+    << std::setw(10) << "time %" << std::setw(12) << "ns/step"
+    << G4endl;
+  const std::size_t nofRows = std::min(entries.size(), std::size_t(fNofRows));
+  for (std::size_t row = 0; row < nofRows; ++row) {
+    const Entry& entry = entries[row];
+    G4cout
+      << std::setw(16) << entry.fVolume << std::setw(16) << entry.fParticle
+      << std::setw(20) << entry.fProcess << std::setw(12) << entry.fNofSteps
+      << std::setw(8) << 100. * entry.fNofSteps / nofSteps
+      << std::setw(14) << entry.fTrackLength / m
+      << std::setw(10) << (time > 0. ? 100. * entry.fTime / time : 0.)
+      << std::setw(12) << std::lround(1.e9 * entry.fTime / entry.fNofSteps)
+      << G4endl;
+  }
+  G4cout.precision(precision);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/StepProfilerMessenger.cc
+/// \brief Implementation of the GdNCap::StepProfilerMessenger class
+
+#include "StepProfilerMessenger.hh"
+#include "StepProfiler.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepProfilerMessenger::StepProfilerMessenger(StepProfiler* profiler)
+: fProfiler(profiler)
+{
+  fDirectory = new G4UIdirectory("/GdNCap/profile/");
+  fDirectory->SetGuidance("Profile of the steps by volume, particle and process");
+
+  fStepsCmd = new G4UIcmdWithABool("/GdNCap/profile/steps", this);
+  fStepsCmd->SetGuidance("Count the steps, their track length and the stepping action");
+  fStepsCmd->SetGuidance("time by (logical volume, particle, process defining the step),");
+  fStepsCmd->SetGuidance("and print the hot spots at the end of each run. Needs the");
+  fStepsCmd->SetGuidance("stepping action, i.e. not the \"sd\" scoring mode.");
+  fStepsCmd->SetParameterName("profile", true);
+  fStepsCmd->SetDefaultValue(true);
+  fStepsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fRowsCmd = new G4UIcmdWithAnInteger("/GdNCap/profile/rows", this);
+  fRowsCmd->SetGuidance("Number of hot spots printed, by decreasing time.");
+  fRowsCmd->SetParameterName("rows", false);
+  fRowsCmd->SetRange("rows>=0");
+  fRowsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/GdNCap/profile/file", this);
+  fFileCmd->SetGuidance("File of the full step profile (default StepProfile.txt).");
+  fFileCmd->SetParameterName("file", false);
+  fFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepProfilerMessenger::~StepProfilerMessenger()
+{
+  delete fFileCmd;
+  delete fRowsCmd;
+  delete fStepsCmd;
+  delete fDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepProfilerMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fStepsCmd) {
+    fProfiler->SetEnabled(fStepsCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fRowsCmd) {
+    fProfiler->SetNofRows(fRowsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fFileCmd) {
+    fProfiler->SetFileName(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
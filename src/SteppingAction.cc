@@ -29,10 +29,13 @@
 
 #include "SteppingAction.hh"
 #include "EventAction.hh"
+#include "CaptureFilter.hh"
 #include "DetectorConstruction.hh"
+#include "StepProfiler.hh"
 
 #include "G4Step.hh"
 #include "G4Event.hh"
+#include "G4Gamma.hh"
 #include "G4RunManager.hh"
 #include "G4LogicalVolume.hh"
 
@@ -43,18 +46,40 @@ namespace GdNCap
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-SteppingAction::SteppingAction(EventAction* eventAction)
-: fEventAction(eventAction)
+SteppingAction::SteppingAction(EventAction* eventAction,
+                               const CaptureFilter* captureFilter,
+                               StepProfiler* stepProfiler)
+: fEventAction(eventAction), fCaptureFilter(captureFilter),
+  fStepProfiler(stepProfiler), fGamma(G4Gamma::Definition())
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void SteppingAction::UserSteppingAction(const G4Step* step)
 {
-  if (!fScoringVolume) {
-    const auto detConstruction = static_cast<const DetectorConstruction*>(
+  if (!fStepProfiler->IsEnabled()) {
+    ScoreStep(step);
+    return;
+  }
+
+  const StepProfiler::Clock::time_point start = StepProfiler::Clock::now();
+  const G4LogicalVolume* volume = ScoreStep(step);
+  fStepProfiler->AddStep(volume, step->GetTrack()->GetParticleDefinition(),
+                         step->GetPostStepPoint()->GetProcessDefinedStep(),
+                         step->GetStepLength(), StepProfiler::Clock::now() - start);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4LogicalVolume* SteppingAction::ScoreStep(const G4Step* step)
+{
+  fEventAction->CountStep();
+
+  // The scoring volume is read at each step: /run/reinitializeGeometry
+  // replaces it between runs
+  if (!fDetConstruction) {
+    fDetConstruction = static_cast<const DetectorConstruction*>(
       G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-    fScoringVolume = detConstruction->GetScoringVolume();
   }
 
   // get volume of the current step
@@ -63,34 +88,68 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
       ->GetVolume()->GetLogicalVolume();
 
   // check if we are in scoring volume
-  if (volume != fScoringVolume) return;
+  if (volume != fDetConstruction->GetScoringVolume()) return volume;
+
+  if (fCaptureFilter->UsesStringMatch()) {
+    RecordByName(step);
+  }
+  else if (const G4VProcess* process = step->GetPostStepPoint()->GetProcessDefinedStep();
+           fCaptureFilter->IsCaptureProcess(process)) {
+    const G4StepPoint* preStepPoint = step->GetPreStepPoint();
+    fEventAction->AddCapture(preStepPoint->GetWeight(),
+      fDetConstruction->GetDepth(preStepPoint->GetTouchable(),
+                                 step->GetPostStepPoint()->GetPosition()));
+    const G4bool buildsCascades = fEventAction->BuildsCascades();
+    fCascade.clear();
+    for (auto secondary : *step->GetSecondaryInCurrentStep()) {
+      ParticleTypeTable::TypeId type;
+      if (fCaptureFilter->IsRecorded(secondary->GetParticleDefinition(), type)) {
+        auto energy = secondary->GetKineticEnergy() / MeV;
+        fEventAction->PushSecondary(energy, type, secondary->GetWeight());
+        fEventAction->AddSecE(energy);
+      }
+      if (buildsCascades && secondary->GetParticleDefinition() == fGamma) {
+        fCascade.push_back(secondary->GetKineticEnergy() / MeV);
+      }
+    }
+    fEventAction->EndCapture();
+    if (buildsCascades) fEventAction->AddCascade(process, fCascade);
+  }
 
+  fEventAction->ScoreNeutronStep(step);
+
+  // collect energy deposited in this step, weighted by the track
+  G4double edepStep = step->GetTotalEnergyDeposit() * step->GetPreStepPoint()->GetWeight();
+  fEventAction->AddEdep(edepStep);
+  return volume;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SteppingAction::RecordByName(const G4Step* step)
+{
+  // Name comparisons on every step, as originally done; kept to compare
+  // the step rate with the pointer comparisons
   const G4StepPoint* postStepPoint = step->GetPostStepPoint();
   const G4String processName = postStepPoint->GetProcessDefinedStep()->GetProcessName();
-  if (processName == "nCapture")
+  if (fCaptureFilter->IsCaptureProcessName(processName))
   {
+      fEventAction->AddCapture(step->GetPreStepPoint()->GetWeight(),
+        fDetConstruction->GetDepth(step->GetPreStepPoint()->GetTouchable(),
+                                   postStepPoint->GetPosition()));
       auto secondaries = step->GetSecondaryInCurrentStep();
-      if (secondaries->size() > 0)
+      for (auto itr = secondaries->begin(); itr != secondaries->end(); ++itr)
       {
-          for (auto itr = secondaries->begin(); itr != secondaries->end(); ++itr)
+          const G4String name = (*itr)->GetParticleDefinition()->GetParticleName();
+          if (fCaptureFilter->IsRecordedParticleName(name))
           {
-              const G4String name = (*itr)->GetParticleDefinition()->GetParticleName();
-              if (name == "gamma" || name == "e-")
-              {
-                  auto energy = (*itr)->GetKineticEnergy() / MeV;
-                  std::pair<G4double, G4String> secondary(energy, name);
-                  fEventAction->PushSecondary(secondary);
-                  fEventAction->AddSecE(energy);
-                  //G4cout << energy << G4endl;
-              }
+              auto energy = (*itr)->GetKineticEnergy() / MeV;
+              fEventAction->PushSecondary(energy, name, (*itr)->GetWeight());
+              fEventAction->AddSecE(energy);
           }
-      }  
+      }
+      fEventAction->EndCapture();
   }
-
-
-  // collect energy deposited in this step
-  G4double edepStep = step->GetTotalEnergyDeposit();
-  fEventAction->AddEdep(edepStep);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,184 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/TextRecordWriter.cc
+/// \brief Implementation of the GdNCap::TextRecordWriter class
+
+#include "TextRecordWriter.hh"
+#include "TextFormat.hh"
+
+namespace
+{
+  // Size of the buffered output above which Write() passes it to the files
+  const std::size_t kBufferSize = 1 << 20;
+}
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TextRecordWriter::~TextRecordWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String TextRecordWriter::GetTotalEnergyFileName(const G4String& suffix)
+{
+  return "SecondaryTotalEnergy" + suffix + ".txt";
+}
+
+G4String TextRecordWriter::GetEnergyFileName(const G4String& suffix)
+{
+  return "SecondaryEnergy" + suffix + ".txt";
+}
+
+G4String TextRecordWriter::GetNameFileName(const G4String& suffix)
+{
+  return "SecondaryName" + suffix + ".txt";
+}
+
+G4String TextRecordWriter::GetWeightFileName(const G4String& suffix)
+{
+  return "SecondaryWeight" + suffix + ".txt";
+}
+
+std::vector<G4String> TextRecordWriter::GetFileNames(const G4String& suffix) const
+{
+  std::vector<G4String> fileNames = { GetTotalEnergyFileName(suffix),
+    GetEnergyFileName(suffix), GetNameFileName(suffix) };
+  if (fWeighted) fileNames.push_back(GetWeightFileName(suffix));
+  return fileNames;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TextRecordWriter::Open(const G4String& suffix)
+{
+  Close();
+  fTotalEnergyFile.open(GetTotalEnergyFileName(suffix), std::ios_base::out);
+  fEnergyFile.open(GetEnergyFileName(suffix), std::ios_base::out);
+  fNameFile.open(GetNameFileName(suffix), std::ios_base::out);
+  if (fWeighted) fWeightFile.open(GetWeightFileName(suffix), std::ios_base::out);
+  fChunk.Clear();
+  fNofEvents = 0;
+  fNofSecondaries = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TextRecordWriter::Write(const CaptureRecordView::Event& event)
+{
+  FormatEvent(event, fChunk);
+  if (fChunk.GetSize() >= kBufferSize) {
+    WriteChunk(fChunk);
+    fChunk.Clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TextRecordWriter::FormatChunk(const std::vector<CaptureRecordView::Event>& events,
+                                   Chunk& chunk) const
+{
+  chunk.Clear();
+  for (const auto& event : events) FormatEvent(event, chunk);
+}
+
+void TextRecordWriter::FormatEvent(const CaptureRecordView::Event& event,
+                                   Chunk& chunk) const
+{
+  if (chunk.fBuffers.size() != kNofBuffers) chunk.fBuffers.resize(kNofBuffers);
+  auto& totalEnergyBuffer = chunk.fBuffers[kTotalEnergyBuffer];
+  auto& energyBuffer = chunk.fBuffers[kEnergyBuffer];
+  auto& nameBuffer = chunk.fBuffers[kNameBuffer];
+  auto& weightBuffer = chunk.fBuffers[kWeightBuffer];
+
+  ++chunk.fNofEvents;
+  if (event.GetTotalEnergy() > 0)
+  {
+      TextFormat::Append(totalEnergyBuffer, event.GetTotalEnergy());
+      totalEnergyBuffer += '\n';
+  }
+  if (event.GetNumberOfSecondaries() > 0)
+  {
+      for (std::size_t i = 0; i < event.GetNumberOfSecondaries(); ++i)
+      {
+          TextFormat::Append(energyBuffer, event.GetEnergy(i));
+          energyBuffer += ' ';
+          nameBuffer += event.GetTypeName(i);
+          nameBuffer += ' ';
+          if (fWeighted)
+          {
+              TextFormat::Append(weightBuffer, event.GetWeight(i));
+              weightBuffer += ' ';
+          }
+      }
+      energyBuffer += '\n';
+      nameBuffer += '\n';
+      if (fWeighted) weightBuffer += '\n';
+      chunk.fNofSecondaries += event.GetNumberOfSecondaries();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TextRecordWriter::WriteChunk(const Chunk& chunk)
+{
+  if (chunk.fBuffers.size() == kNofBuffers) {
+    const auto& totalEnergyBuffer = chunk.fBuffers[kTotalEnergyBuffer];
+    const auto& energyBuffer = chunk.fBuffers[kEnergyBuffer];
+    const auto& nameBuffer = chunk.fBuffers[kNameBuffer];
+    fTotalEnergyFile.write(totalEnergyBuffer.data(), totalEnergyBuffer.size());
+    fEnergyFile.write(energyBuffer.data(), energyBuffer.size());
+    fNameFile.write(nameBuffer.data(), nameBuffer.size());
+    if (fWeighted) {
+      const auto& weightBuffer = chunk.fBuffers[kWeightBuffer];
+      fWeightFile.write(weightBuffer.data(), weightBuffer.size());
+    }
+  }
+  fNofEvents += chunk.fNofEvents;
+  fNofSecondaries += chunk.fNofSecondaries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TextRecordWriter::Close()
+{
+  if (!IsOpen()) return;
+  WriteChunk(fChunk);
+  fChunk.Clear();
+  fTotalEnergyFile.close();
+  fEnergyFile.close();
+  fNameFile.close();
+  if (fWeightFile.is_open()) fWeightFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
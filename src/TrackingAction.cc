@@ -0,0 +1,98 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/TrackingAction.cc
+/// \brief Implementation of the GdNCap::TrackingAction class
+
+#include "TrackingAction.hh"
+#include "EventAction.hh"
+#include "CaptureFilter.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Gamma.hh"
+#include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4TrackingManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TrackingAction::TrackingAction(EventAction* eventAction,
+                               const CaptureFilter* captureFilter)
+: fEventAction(eventAction), fCaptureFilter(captureFilter),
+  fGamma(G4Gamma::Definition())
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  // Only tracks ended by a capture process
+  const G4Step* lastStep = track->GetStep();
+  if (!lastStep) return;
+  const G4VProcess* process = lastStep->GetPostStepPoint()->GetProcessDefinedStep();
+  if (!fCaptureFilter->IsCaptureProcess(process)) return;
+
+  if (!fDetConstruction) {
+    fDetConstruction = static_cast<const DetectorConstruction*>(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  }
+
+  // The capture is in the volume of the last step's pre-step point
+  const G4StepPoint* preStepPoint = lastStep->GetPreStepPoint();
+  const G4VPhysicalVolume* volume = preStepPoint->GetTouchableHandle()->GetVolume();
+  if (!volume || volume->GetLogicalVolume() != fDetConstruction->GetScoringVolume()) return;
+  fEventAction->AddCapture(preStepPoint->GetWeight(),
+    fDetConstruction->GetDepth(preStepPoint->GetTouchable(), track->GetPosition()));
+
+  // The track's secondaries include those of earlier interactions
+  const G4bool buildsCascades = fEventAction->BuildsCascades();
+  fCascade.clear();
+  for (auto secondary : *fpTrackingManager->GimmeSecondaries()) {
+    if (!fCaptureFilter->IsCaptureProcess(secondary->GetCreatorProcess())) continue;
+    ParticleTypeTable::TypeId type;
+    if (fCaptureFilter->IsRecorded(secondary->GetParticleDefinition(), type)) {
+      auto energy = secondary->GetKineticEnergy() / MeV;
+      fEventAction->PushSecondary(energy, type, secondary->GetWeight());
+      fEventAction->AddSecE(energy);
+    }
+    if (buildsCascades && secondary->GetParticleDefinition() == fGamma) {
+      fCascade.push_back(secondary->GetKineticEnergy() / MeV);
+    }
+  }
+  fEventAction->EndCapture();
+  if (buildsCascades) fEventAction->AddCascade(process, fCascade);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,86 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/VRecordWriter.cc
+/// \brief Implementation of the GdNCap::VRecordWriter class
+
+#include "VRecordWriter.hh"
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VRecordWriter::Chunk::Clear()
+{
+  // Keep the buffers' capacity for the next chunk
+  for (auto& buffer : fBuffers) buffer.clear();
+  fRecordEnds.clear();
+  fNofEvents = 0;
+  fNofSecondaries = 0;
+}
+
+std::size_t VRecordWriter::Chunk::GetSize() const
+{
+  std::size_t size = 0;
+  for (const auto& buffer : fBuffers) size += buffer.size();
+  return size;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VRecordWriter::FormatChunk(const std::vector<CaptureRecordView::Event>&,
+                                Chunk&) const
+{
+  G4Exception("VRecordWriter::FormatChunk()", "MyCode0007",
+    FatalException, "This record writer cannot format chunks.");
+}
+
+void VRecordWriter::WriteChunk(const Chunk&)
+{
+  G4Exception("VRecordWriter::WriteChunk()", "MyCode0007",
+    FatalException, "This record writer cannot write chunks.");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VRecordWriter::Write(const CaptureRecordBlock& block)
+{
+  for (std::size_t row = 0; row < block.GetNumberOfEvents(); ++row) {
+    Write(CaptureRecordView::Event(&block, row));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VRecordWriter::Write(const CaptureRecordView& view)
+{
+  view.ForEachEvent([this](const CaptureRecordView::Event& event) { Write(event); });
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
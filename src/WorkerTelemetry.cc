@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file GdNCap/src/WorkerTelemetry.cc
+/// \brief Implementation of the GdNCap::WorkerTelemetry class
+
+#include "WorkerTelemetry.hh"
+
+#include <algorithm>
+#include <ctime>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GDNCAP_HAVE_THREAD_CPUTIME 1
+#endif
+
+namespace GdNCap
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WorkerTelemetry::Merge(const G4VAccumulable& other)
+{
+  const auto& otherTelemetry = static_cast<const WorkerTelemetry&>(other);
+  fWorkers.insert(fWorkers.end(), otherTelemetry.fWorkers.begin(),
+                  otherTelemetry.fWorkers.end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WorkerTelemetry::Reset()
+{
+  fWorkers.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WorkerTelemetry::Begin(G4int threadId)
+{
+  fWorkers.clear();
+  fWorkers.emplace_back();
+  fWorkers.back().fThreadId = threadId;
+}
+
+void WorkerTelemetry::AddEvent(G4double wallTime, G4double cpuTime,
+                               G4double userActionTime)
+{
+  if (fWorkers.empty()) return;
+  Worker& worker = fWorkers.back();
+  ++worker.fNofEvents;
+  worker.fWallTime += wallTime;
+  worker.fCpuTime += cpuTime;
+  worker.fUserActionTime += userActionTime;
+}
+
+void WorkerTelemetry::AddWriteTime(G4double writeTime)
+{
+  if (!fWorkers.empty()) fWorkers.back().fWriteTime += writeTime;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double WorkerTelemetry::GetImbalance() const
+{
+  if (fWorkers.empty()) return 1.;
+  G4double sum = 0.;
+  G4double max = 0.;
+  for (const auto& worker : fWorkers) {
+    sum += worker.fWallTime;
+    max = std::max(max, worker.fWallTime);
+  }
+  return sum > 0. ? max * fWorkers.size() / sum : 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double WorkerTelemetry::GetThreadCpuTime()
+{
+  // Elsewhere the CPU time of the process, meaningful with one thread only
+#ifdef GDNCAP_HAVE_THREAD_CPUTIME
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+    return time.tv_sec + 1.e-9 * time.tv_nsec;
+  }
+#endif
+  return G4double(std::clock()) / CLOCKS_PER_SEC;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}